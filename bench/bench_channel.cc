@@ -0,0 +1,315 @@
+#include "gocoroutine/channel.h"
+#include "gocoroutine/executor.h"
+#include "gocoroutine/ring_buffer.h"
+#include "gocoroutine/task.h"
+#include "gocoroutine/utils.h"
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <span>
+#include <thread>
+#include <vector>
+
+using namespace gocoroutine;
+
+// channel 缓冲区测试，一个生产者线程与一个消费者线程，缓冲区满/空时让出 CPU
+// std::queue + mutex: 原 Channel 的缓冲方式（std::queue 在 channel 锁内读写），
+//                     仅比较缓冲区本身，原 Channel 的端到端对照见 LockedChannel
+// MpmcRingBuffer:     多生产者多消费者无锁环形队列
+// SpscRingBuffer:     单生产者单消费者无锁环形队列
+// 之后分别在单线程与两个线程的线程池上测试 Channel 的端到端吞吐，以及批量读写的吞吐
+// LockedChannel<int>: 按原 Channel 实现的端到端对照，每次读写都挂起，在 channel 锁内
+//                     操作 std::queue 与 std::list 等待队列，并经由调度器恢复协程
+//                     原实现读端既不入队也不恢复协程，无法直接运行，此处补齐这两处
+
+constexpr int kMessageCount = 1000000;
+constexpr std::size_t kCapacity = 1024;
+
+class LockedQueue {
+public:
+	bool try_push(int value) {
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (queue_.size() >= kCapacity)
+			return false;
+
+		queue_.push(value);
+		return true;
+	}
+
+	std::optional<int> try_pop() {
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (queue_.empty())
+			return std::nullopt;
+
+		auto value = queue_.front();
+		queue_.pop();
+		return value;
+	}
+
+private:
+	std::mutex mutex_{};
+	std::queue<int> queue_{};
+};
+
+template <typename T> class LockedChannel {
+public:
+	class Writer {
+	public:
+		Writer(LockedChannel* channel, T value)
+		    : channel_(channel)
+		    , value_(value) {}
+
+	public:
+		bool await_ready() { return false; }
+
+		void await_suspend(std::coroutine_handle<> handle) {
+			handle_ = handle;
+			channel_->try_push_writer(this);
+		}
+
+		void await_resume() {}
+
+		void resume() {
+			executor_->execute([this]() { handle_.resume(); });
+		}
+
+	public:
+		LockedChannel* channel_{};
+		AbstractExecutor* executor_{};
+		T value_{};
+		std::coroutine_handle<> handle_{};
+	};
+
+	class Reader {
+	public:
+		explicit Reader(LockedChannel* channel)
+		    : channel_(channel) {}
+
+	public:
+		bool await_ready() { return false; }
+
+		void await_suspend(std::coroutine_handle<> handle) {
+			handle_ = handle;
+			channel_->try_push_reader(this);
+		}
+
+		T await_resume() { return value_; }
+
+		void resume(T value) {
+			value_ = value;
+			executor_->execute([this]() { handle_.resume(); });
+		}
+
+	public:
+		LockedChannel* channel_{};
+		AbstractExecutor* executor_{};
+		T value_{};
+		std::coroutine_handle<> handle_{};
+	};
+
+public:
+	explicit LockedChannel(std::size_t capacity)
+	    : capacity_(capacity) {}
+
+	Writer write(T value) { return Writer(this, value); }
+	Reader read() { return Reader(this); }
+
+	void try_push_reader(Reader* reader) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (!buffer_.empty()) {
+			auto value = buffer_.front();
+			buffer_.pop();
+
+			Writer* writer = nullptr;
+			if (!writer_list_.empty()) {
+				writer = writer_list_.front();
+				writer_list_.pop_front();
+				buffer_.push(writer->value_);
+			}
+			lock.unlock();
+
+			if (writer)
+				writer->resume();
+			reader->resume(value);
+			return;
+		}
+
+		if (!writer_list_.empty()) {
+			auto writer = writer_list_.front();
+			writer_list_.pop_front();
+			lock.unlock();
+
+			reader->resume(writer->value_);
+			writer->resume();
+			return;
+		}
+
+		reader_list_.push_back(reader);
+	}
+
+	void try_push_writer(Writer* writer) {
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (!reader_list_.empty()) {
+			auto reader = reader_list_.front();
+			reader_list_.pop_front();
+			lock.unlock();
+
+			reader->resume(writer->value_);
+			writer->resume();
+			return;
+		}
+
+		if (buffer_.size() < capacity_) {
+			buffer_.push(writer->value_);
+			lock.unlock();
+			writer->resume();
+			return;
+		}
+
+		writer_list_.push_back(writer);
+	}
+
+private:
+	std::size_t capacity_{};
+	std::queue<T> buffer_{};
+	std::list<Writer*> writer_list_{};
+	std::list<Reader*> reader_list_{};
+	std::mutex mutex_{};
+};
+
+template <typename Func> double measure(Func&& func) {
+	auto start = std::chrono::steady_clock::now();
+	func();
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double>(end - start).count();
+}
+
+void report(const char* name, double seconds) {
+	fmt::print("{:<28} {:>12.0f} msgs/s\n", name, kMessageCount / seconds);
+}
+
+template <typename Queue> double run_buffer(Queue& queue) {
+	return measure([&queue]() {
+		auto producer = std::thread([&queue]() {
+			for (int i = 0; i < kMessageCount; ++i) {
+				while (!queue.try_push(i)) {
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		long long sum = 0;
+		for (int i = 0; i < kMessageCount; ++i) {
+			auto value = queue.try_pop();
+			while (!value) {
+				std::this_thread::yield();
+				value = queue.try_pop();
+			}
+			sum += *value;
+		}
+
+		producer.join();
+	});
+}
+
+template <typename Channel_>
+Task<void, ThreadPoolExecutor> produce(Channel_& channel) {
+	for (int i = 0; i < kMessageCount; ++i) {
+		co_await channel.write(i);
+	}
+}
+
+template <typename Channel_>
+Task<long long, ThreadPoolExecutor> consume(Channel_& channel) {
+	long long sum = 0;
+	for (int i = 0; i < kMessageCount; ++i) {
+		sum += co_await channel.read();
+	}
+	co_return sum;
+}
+
+constexpr std::size_t kBatchSize = 256;
+
+template <typename Channel_>
+Task<void, ThreadPoolExecutor> produce_batch(Channel_& channel) {
+	std::vector<int> values(kBatchSize);
+	for (int i = 0; i < kMessageCount; i += int(kBatchSize)) {
+		auto count = std::min(kBatchSize, std::size_t(kMessageCount - i));
+		auto pending = std::span<int>(values.data(), count);
+		while (!pending.empty()) {
+			pending = pending.subspan(co_await channel.write_batch(pending));
+		}
+	}
+}
+
+template <typename Channel_>
+Task<long long, ThreadPoolExecutor> consume_batch(Channel_& channel) {
+	long long sum = 0;
+	for (int i = 0; i < kMessageCount;) {
+		auto values = co_await channel.read_batch(kBatchSize);
+		for (auto value : values) {
+			sum += value;
+		}
+		i += int(values.size());
+	}
+	co_return sum;
+}
+
+template <typename Channel_> double run_channel_batch() {
+	Channel_ channel(kCapacity);
+	return measure([&channel]() {
+		auto consumer = consume_batch(channel);
+		auto producer = produce_batch(channel);
+
+		producer.get_result();
+		consumer.get_result();
+	});
+}
+
+template <typename Channel_> double run_channel() {
+	Channel_ channel(kCapacity);
+	return measure([&channel]() {
+		auto consumer = consume(channel);
+		auto producer = produce(channel);
+
+		producer.get_result();
+		consumer.get_result();
+	});
+}
+
+// 在 worker_count 个线程的线程池上测试各 Channel 的端到端吞吐
+// 单线程时挂起与恢复均在同一线程内完成，多线程时唤醒挂起方需要唤醒另一个工作线程
+void report_channels(std::size_t worker_count) {
+	auto pool = ThreadPoolExecutor(worker_count);
+	SharedExecutor<ThreadPoolExecutor>::set(&pool);
+
+	fmt::print("ThreadPoolExecutor({})\n", worker_count);
+	report("LockedChannel<int>", run_channel<LockedChannel<int>>());
+	report("Channel<int>", run_channel<Channel<int>>());
+	report("SpscChannel<int>", run_channel<SpscChannel<int>>());
+	report("Channel<int> batch", run_channel_batch<Channel<int>>());
+	report("UnboundedChannel<int>", run_channel<UnboundedChannel<int>>());
+
+	SharedExecutor<ThreadPoolExecutor>::set(nullptr);
+}
+
+int main() {
+	LockedQueue locked_queue;
+	report("std::queue + mutex", run_buffer(locked_queue));
+
+	MpmcRingBuffer<int> mpmc(kCapacity);
+	report("MpmcRingBuffer", run_buffer(mpmc));
+
+	SpscRingBuffer<int> spsc(kCapacity);
+	report("SpscRingBuffer", run_buffer(spsc));
+
+	report_channels(1);
+	report_channels(2);
+	return 0;
+}
@@ -0,0 +1,65 @@
+#include "gocoroutine/executor.h"
+#include "gocoroutine/task.h"
+#include "gocoroutine/utils.h"
+#include <chrono>
+#include <future>
+#include <vector>
+
+using namespace gocoroutine;
+
+// 协程任务创建速率测试
+// before: 每个协程独立构造 LooperExecutor（即原 TaskPromise 按值持有调度器的开销）
+// after:  同类型协程共享 SharedExecutor<LooperExecutor> 实例
+
+Task<void, LooperExecutor> empty_task() { co_return; }
+
+template <typename Func> double measure(int count, Func&& func) {
+	auto start = std::chrono::steady_clock::now();
+	func();
+	auto end = std::chrono::steady_clock::now();
+
+	auto seconds = std::chrono::duration<double>(end - start).count();
+	return count / seconds;
+}
+
+// 等待共享调度器上此前投递的任务全部执行完成
+void drain_shared_looper() {
+	std::promise<void> barrier;
+	SharedExecutor<LooperExecutor>::get()->execute(
+	    [&barrier]() { barrier.set_value(); });
+	barrier.get_future().wait();
+}
+
+int main() {
+	constexpr int kPerTaskExecutorCount = 2000;
+	constexpr int kSharedExecutorCount = 100000;
+
+	auto before = measure(kPerTaskExecutorCount, []() {
+		for (int i = 0; i < kPerTaskExecutorCount; ++i) {
+			auto executor = LooperExecutor();
+			executor.execute([]() {});
+			executor.shutdown();
+		}
+	});
+
+	auto after = measure(kSharedExecutorCount, []() {
+		std::vector<Task<void, LooperExecutor>> tasks;
+		tasks.reserve(kSharedExecutorCount);
+
+		for (int i = 0; i < kSharedExecutorCount; ++i) {
+			tasks.emplace_back(empty_task());
+		}
+
+		for (auto& task : tasks) {
+			task.get_result();
+		}
+
+		drain_shared_looper();
+	});
+
+	fmt::print("per-task executor (before): {:>12.0f} tasks/s\n", before);
+	fmt::print("shared executor   (after):  {:>12.0f} tasks/s\n", after);
+	fmt::print("speedup: {:.1f}x\n", after / before);
+
+	return 0;
+}
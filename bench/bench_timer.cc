@@ -0,0 +1,184 @@
+#include "gocoroutine/executor.h"
+#include "gocoroutine/scheduler.h"
+#include "gocoroutine/task.h"
+#include "gocoroutine/timing_wheel.h"
+#include "gocoroutine/utils.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <sys/resource.h>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace gocoroutine;
+
+// 定时器测试，100 万个同时等待的定时事件
+// priority_queue: 原 Scheduler 使用的二叉堆实现，作为对照
+// TimingWheel:    分层时间轮插入及全部到期取出
+// Scheduler:      加锁后的 execute 调用开销
+// slack:          1 万个 1s 内随机到期的定时事件，不同合并窗口下的上下文切换次数
+// looper slack:   同上，改为 LooperExecutor 上 1 万个协程 co_await 延时
+// pool slack:     同上，改为 2 个工作线程的 ThreadPoolExecutor
+
+constexpr int kTimerCount = 1000000;
+
+template <typename Func> double measure(Func&& func) {
+	auto start = std::chrono::steady_clock::now();
+	func();
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+std::vector<int64_t> make_delays() {
+	std::vector<int64_t> delays;
+	delays.reserve(kTimerCount);
+
+	// 1s ~ 60s 之间的伪随机延时，单位毫秒
+	uint64_t seed = 42;
+	for (int i = 0; i < kTimerCount; ++i) {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		delays.push_back(1000 + static_cast<int64_t>(seed >> 33) % 59000);
+	}
+
+	return delays;
+}
+
+// 进程主动上下文切换次数，Scheduler 每次挂起等待计一次
+long voluntary_switches() {
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_nvcsw;
+}
+
+void report_slack(std::chrono::milliseconds slack) {
+	constexpr int kSlackTimerCount = 10000;
+	std::atomic<int> fired{0};
+
+	auto scheduler = Scheduler(slack);
+	auto start = voluntary_switches();
+
+	uint64_t seed = 7;
+	for (int i = 0; i < kSlackTimerCount; ++i) {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		auto delay = std::chrono::microseconds((seed >> 33) % 1000000);
+		scheduler.execute([&fired]() { fired.fetch_add(1); }, delay);
+	}
+
+	scheduler.shutdown();
+	scheduler.join();
+
+	fmt::print("slack {:>4} ms {:>10} timers  {:>8} context switches\n",
+	           slack.count(), fired.load(), voluntary_switches() - start);
+}
+
+template <typename Executor>
+Task<void, Executor> sleeper(int64_t delay, std::atomic<int>& fired) {
+	co_await std::chrono::microseconds(delay);
+	fired.fetch_add(1);
+}
+
+// executor 需以 slack 构造，结束后关闭
+template <typename Executor>
+void report_executor_slack(const char* name, Executor& executor,
+                           std::chrono::milliseconds slack) {
+	constexpr int kSleeperCount = 10000;
+	std::atomic<int> fired{0};
+
+	SharedExecutor<Executor>::set(&executor);
+	auto start = voluntary_switches();
+
+	{
+		std::vector<Task<void, Executor>> sleepers;
+		sleepers.reserve(kSleeperCount);
+
+		uint64_t seed = 7;
+		for (int i = 0; i < kSleeperCount; ++i) {
+			seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+			auto delay = static_cast<int64_t>((seed >> 33) % 1000000);
+			sleepers.emplace_back(sleeper<Executor>(delay, fired));
+		}
+
+		// 主线程低频轮询，切换次数主要来自执行线程等待定时事件
+		while (fired.load() < kSleeperCount) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+	}
+
+	executor.shutdown();
+	executor.join();
+	SharedExecutor<Executor>::set(nullptr);
+
+	fmt::print("{:<6} slack {:>4} ms {:>10} sleeps  {:>8} context switches\n",
+	           name, slack.count(), fired.load(), voluntary_switches() - start);
+}
+
+void report(const char* name, double ms) {
+	fmt::print("{:<28} {:>10.1f} ms  {:>8.1f} ns/timer\n", name, ms,
+	           ms * 1e6 / kTimerCount);
+}
+
+int main() {
+	auto delays = make_delays();
+
+	using Entry = std::pair<int64_t, std::function<void()>>;
+	auto compare = [](const Entry& left, const Entry& right) {
+		return left.first > right.first;
+	};
+	std::priority_queue<Entry, std::vector<Entry>, decltype(compare)> heap(
+	    compare);
+
+	report("priority_queue push", measure([&]() {
+		       for (auto delay : delays) {
+			       heap.emplace(delay, []() {});
+		       }
+	       }));
+
+	report("priority_queue pop all", measure([&]() {
+		       while (!heap.empty()) {
+			       heap.pop();
+		       }
+	       }));
+
+	auto wheel = TimingWheel(0);
+	report("TimingWheel add", measure([&]() {
+		       for (auto delay : delays) {
+			       wheel.add([]() {}, delay);
+		       }
+	       }));
+
+	report("TimingWheel expire all", measure([&]() {
+		       IntrusiveList<DelayedExecutable> expired;
+		       wheel.advance(60000, expired);
+		       wheel.release(expired);
+	       }));
+
+	auto scheduler = Scheduler();
+	report("Scheduler execute", measure([&]() {
+		       for (auto delay : delays) {
+			       scheduler.execute([]() {}, delay);
+		       }
+	       }));
+
+	scheduler.shutdown(false);
+	scheduler.join();
+
+	for (int slack : {0, 1, 10}) {
+		report_slack(std::chrono::milliseconds(slack));
+	}
+
+	for (int slack : {0, 1, 10}) {
+		auto looper = LooperExecutor(std::chrono::milliseconds(slack));
+		report_executor_slack("looper", looper, std::chrono::milliseconds(slack));
+	}
+
+	for (int slack : {0, 1, 10}) {
+		auto pool = ThreadPoolExecutor(2, std::chrono::milliseconds(slack));
+		report_executor_slack("pool", pool, std::chrono::milliseconds(slack));
+	}
+
+	return 0;
+}
@@ -0,0 +1,488 @@
+#ifndef GOCOROUTINE_BROADCAST_CHANNEL_H
+#define GOCOROUTINE_BROADCAST_CHANNEL_H
+
+#include "gocoroutine/channel_awaiter.h"
+#include "gocoroutine/intrusive_list.h"
+#include "gocoroutine/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+GOCOROUTINE_NAMESPACE_BEGIN
+
+// 慢订阅者处理策略，即写入时最慢的订阅者尚未读取的数据将被覆盖
+enum class BroadcastPolicy {
+	kDropOldest, // 覆盖最旧的数据，慢订阅者跳过被覆盖的部分，记入 dropped()
+	kBlock,      // 写方挂起，直至最慢的订阅者读取
+	kDisconnect, // 断开慢订阅者，其后续读取视为 channel 已关闭
+};
+
+// 广播 channel，每个写入的值被所有订阅者各读取一次
+// 所有订阅者共享一个环形缓冲区（槽位数向上取整为 2 的幂，最慢订阅者至多落后 capacity 个值），
+// 每个订阅者只保存自己的读取位置，
+// 写入的值只存储一次（std::shared_ptr<const T>），订阅者读到的是共享的只读句柄，
+// 不按订阅者复制，T 可以是仅可移动类型
+// 订阅者只能读到订阅之后写入的值
+//
+// 写方复用 WriterAwaiter，读方以 Subscriber 作为 channel 类型复用 ReaderAwaiter，
+// 关闭语义与 Channel 相同：订阅者读完剩余数据后 read 抛出异常、read_optional 返回空值
+template <typename T> class BroadcastChannel {
+
+public:
+	class ChannelClosedException : public std::exception {
+	public:
+		const char* what() const noexcept override { /* NOLINT */
+			return "Channel is closed";
+		}
+	};
+
+	class Subscriber;
+
+	// 订阅者读取到的值
+	using Value = std::shared_ptr<const T>;
+
+	using value_type = T;
+	using Writer = WriterAwaiter<T, BroadcastChannel>;
+	using ResultWriter = ResultWriterAwaiter<T, BroadcastChannel>;
+	using Reader = ReaderAwaiter<Value, Subscriber>;
+
+	// 订阅者，析构时取消订阅，需在其读取协程结束后、channel 析构前析构
+	class Subscriber {
+
+	public:
+		using value_type = Value;
+		using Reader = ReaderAwaiter<Value, Subscriber>;
+		using OptionalReader = OptionalReaderAwaiter<Value, Subscriber>;
+		using TargetReader = TargetReaderAwaiter<Value, Subscriber>;
+		using ResultReader = ResultReaderAwaiter<Value, Subscriber>;
+
+		explicit Subscriber(BroadcastChannel& channel)
+		    : channel_(&channel) {
+			channel_->subscribe(this);
+		}
+
+		~Subscriber() { channel_->unsubscribe(this); }
+
+		Subscriber(const Subscriber&) = delete;
+		Subscriber& operator=(const Subscriber&) = delete;
+
+	public:
+		Reader read() { return Reader(this); }
+		OptionalReader read_optional() { return OptionalReader(this); }
+		ResultReader read_result() { return ResultReader(this); }
+
+		TargetReader operator>>(Value& value_ref) {
+			return TargetReader(this, &value_ref);
+		}
+
+		// 非阻塞读取，无可读数据时返回 std::nullopt，已关闭或已断开且读完时抛出异常
+		std::optional<Value> try_read() {
+			Value value;
+			if (channel_->try_take(this, value))
+				return std::optional<Value>(std::move(value));
+
+			check_closed();
+			return std::nullopt;
+		}
+
+		// 因写入过快被覆盖而跳过的值的数量，仅 kDropOldest 策略下累计
+		std::uint64_t dropped() const {
+			return dropped_.load(std::memory_order_relaxed);
+		}
+
+		// 是否因读取过慢被断开，仅 kDisconnect 策略下出现
+		bool is_disconnected() const {
+			return disconnected_.load(std::memory_order_relaxed);
+		}
+
+		void check_closed() {
+			if (is_disconnected() || !channel_->is_active()) {
+				throw ChannelClosedException();
+			}
+		}
+
+	public:
+		// 以下供 ReaderAwaiter 调用，语义同 Channel 中的同名函数
+		bool try_ready_reader(Reader* reader) {
+			return channel_->try_ready_reader(this, reader);
+		}
+
+		bool try_push_reader(Reader* reader) {
+			return channel_->try_push_reader(this, reader);
+		}
+
+		bool try_read_into(Reader* reader) {
+			return channel_->try_read_into(this, reader);
+		}
+
+		void remove_reader(Reader* reader) { channel_->remove_reader(reader); }
+
+	private:
+		friend class BroadcastChannel;
+
+		BroadcastChannel* channel_{};
+		std::uint64_t cursor_{}; // 下一个待读取值的序号，由 channel 的锁保护
+		std::atomic<std::uint64_t> dropped_{};
+		std::atomic<bool> disconnected_{};
+
+	public:
+		Subscriber* prev_{};
+		Subscriber* next_{};
+		IntrusiveList<Subscriber>* list_{};
+	};
+
+public:
+	explicit BroadcastChannel(std::size_t capacity,
+	                          BroadcastPolicy policy = BroadcastPolicy::kBlock)
+	    : policy_(policy)
+	    , capacity_(std::max<std::size_t>(capacity, 1))
+	    , slots_(std::bit_ceil(capacity_))
+	    , mask_(slots_.size() - 1) {
+
+		is_active_.store(true, std::memory_order_relaxed);
+	}
+
+	~BroadcastChannel() { close(); }
+
+	BroadcastChannel(const BroadcastChannel&) = delete;
+	BroadcastChannel& operator=(const BroadcastChannel&) = delete;
+
+public:
+	bool is_active() { return is_active_.load(std::memory_order_acquire); }
+
+	void check_closed() {
+		if (!is_active()) {
+			throw ChannelClosedException();
+		}
+	}
+
+	Writer write(T value) {
+		check_closed();
+		return Writer(this, std::move(value));
+	}
+
+	Writer operator<<(T value) { return write(std::move(value)); }
+
+	ResultWriter write_result(T value) {
+		return ResultWriter(this, std::move(value));
+	}
+
+	// 非阻塞写入，kBlock 策略下缓冲区已满时返回 false，此时 value 保持不变
+	bool try_write(T&& value) {
+		check_closed();
+
+		std::vector<Reader*> readers;
+		{
+			std::lock_guard<std::mutex> lk(mutex_);
+			if (policy_ == BroadcastPolicy::kBlock && full())
+				return false;
+
+			publish(std::move(value), readers);
+		}
+
+		resume_all(readers);
+		return true;
+	}
+
+	bool try_write(const T& value) {
+		T copy(value);
+		return try_write(std::move(copy));
+	}
+
+	std::size_t subscriber_count() {
+		std::lock_guard<std::mutex> lk(mutex_);
+		return subscribers_.size();
+	}
+
+	std::size_t capacity() const { return capacity_; }
+
+	// 关闭后写入抛出异常，挂起的读写方均被唤醒，订阅者仍可读完缓冲区中的数据
+	void close() {
+		bool expect = true;
+		if (!is_active_.compare_exchange_strong(expect, false,
+		                                        std::memory_order_acq_rel))
+			return;
+
+		std::vector<Writer*> writers;
+		std::vector<Reader*> readers;
+		{
+			std::lock_guard<std::mutex> lk(mutex_);
+			while (auto writer = writer_list_.pop_front()) {
+				writer->closed_ = true;
+				writers.push_back(writer);
+			}
+
+			while (auto reader = reader_list_.pop_front()) {
+				reader->closed_ = true;
+				readers.push_back(reader);
+			}
+		}
+
+		resume_all(writers);
+		resume_all(readers);
+	}
+
+public:
+	// 以下供 WriterAwaiter 调用，语义同 Channel 中的同名函数
+	bool try_ready_writer(Writer* writer) {
+		if (!is_active()) {
+			writer->closed_ = true;
+			return true;
+		}
+
+		std::vector<Reader*> readers;
+		{
+			std::lock_guard<std::mutex> lk(mutex_);
+			if (policy_ == BroadcastPolicy::kBlock && full())
+				return false;
+
+			publish(std::move(writer->value_), readers);
+		}
+
+		resume_all(readers);
+		return true;
+	}
+
+	bool try_push_writer(Writer* writer) {
+		std::vector<Reader*> readers;
+		{
+			std::lock_guard<std::mutex> lk(mutex_);
+			if (!is_active()) {
+				writer->closed_ = true;
+				return false;
+			}
+
+			if (policy_ == BroadcastPolicy::kBlock && full()) {
+				writer_list_.push_back(writer);
+				return true;
+			}
+
+			publish(std::move(writer->value_), readers);
+		}
+
+		resume_all(readers);
+		return false;
+	}
+
+	void remove_writer(Writer* writer) {
+		std::lock_guard<std::mutex> lk(mutex_);
+		if (writer_list_.contains(writer)) {
+			writer_list_.remove(writer);
+		}
+	}
+
+private:
+	void subscribe(Subscriber* subscriber) {
+		std::lock_guard<std::mutex> lk(mutex_);
+		subscriber->cursor_ = tail_;
+		subscribers_.push_back(subscriber);
+	}
+
+	// 取消订阅可能使挂起的写方可以继续
+	void unsubscribe(Subscriber* subscriber) {
+		std::vector<Reader*> readers;
+		std::vector<Writer*> writers;
+		{
+			std::lock_guard<std::mutex> lk(mutex_);
+			if (subscribers_.contains(subscriber)) {
+				subscribers_.remove(subscriber);
+			}
+			release_writers(readers, writers);
+		}
+
+		resume_all(readers);
+		resume_all(writers);
+	}
+
+	bool try_take(Subscriber* subscriber, Value& value) {
+		std::vector<Reader*> readers;
+		std::vector<Writer*> writers;
+		{
+			std::lock_guard<std::mutex> lk(mutex_);
+			if (!take(subscriber, value))
+				return false;
+
+			release_writers(readers, writers);
+		}
+
+		resume_all(readers);
+		resume_all(writers);
+		return true;
+	}
+
+	bool try_read_into(Subscriber* subscriber, Reader* reader) {
+		Value value;
+		if (!try_take(subscriber, value))
+			return false;
+
+		reader->resume(std::move(value));
+		return true;
+	}
+
+	bool try_ready_reader(Subscriber* subscriber, Reader* reader) {
+		if (try_read_into(subscriber, reader))
+			return true;
+
+		if (!is_active() || subscriber->is_disconnected()) {
+			reader->closed_ = true;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool try_push_reader(Subscriber* subscriber, Reader* reader) {
+		std::vector<Reader*> readers;
+		std::vector<Writer*> writers;
+		{
+			std::lock_guard<std::mutex> lk(mutex_);
+
+			Value value;
+			if (take(subscriber, value)) {
+				release_writers(readers, writers);
+				reader->resume(std::move(value));
+			} else if (!is_active() || subscriber->is_disconnected()) {
+				reader->closed_ = true;
+			} else {
+				reader_list_.push_back(reader);
+				return true;
+			}
+		}
+
+		resume_all(readers);
+		resume_all(writers);
+		return false;
+	}
+
+	void remove_reader(Reader* reader) {
+		std::lock_guard<std::mutex> lk(mutex_);
+		if (reader_list_.contains(reader)) {
+			reader_list_.remove(reader);
+		}
+	}
+
+private:
+	// 以下均在锁内调用
+
+	// 读取订阅者的下一个值，kDropOldest 策略下先跳过已被覆盖的部分
+	// 只复制共享句柄，不复制值本身
+	bool take(Subscriber* subscriber, Value& value) {
+		if (subscriber->is_disconnected())
+			return false;
+
+		if (tail_ - subscriber->cursor_ > capacity_) {
+			auto oldest = tail_ - capacity_;
+			subscriber->dropped_.fetch_add(oldest - subscriber->cursor_,
+			                               std::memory_order_relaxed);
+			subscriber->cursor_ = oldest;
+		}
+
+		if (subscriber->cursor_ == tail_)
+			return false;
+
+		value = slots_[subscriber->cursor_ & mask_];
+		++subscriber->cursor_;
+		return true;
+	}
+
+	// 最慢的订阅者是否已落后整个缓冲区，min_cursor_ 只可能偏小，仅在看似已满时重新计算
+	bool full() {
+		if (tail_ - min_cursor_ < capacity_)
+			return false;
+
+		min_cursor_ = tail_;
+		for (auto subscriber = subscribers_.front(); subscriber;
+		     subscriber = subscriber->next_) {
+			min_cursor_ = std::min(min_cursor_, subscriber->cursor_);
+		}
+
+		return tail_ - min_cursor_ >= capacity_;
+	}
+
+	// 写入一个值，并交给等待中的读方，被唤醒的读方由调用方在锁外恢复
+	void publish(T&& value, std::vector<Reader*>& woken) {
+		if (policy_ == BroadcastPolicy::kDisconnect && full()) {
+			disconnect_lagging();
+		}
+
+		slots_[tail_ & mask_] = std::make_shared<const T>(std::move(value));
+		++tail_;
+
+		// 同一订阅者有多个挂起的读方时只有第一个能读到，其余继续挂起
+		auto reader = reader_list_.front();
+		while (reader) {
+			auto next = reader->next_;
+			Value shared;
+			if (take(reader->channel_, shared)) {
+				reader_list_.remove(reader);
+				reader->resume(std::move(shared));
+				woken.push_back(reader);
+			}
+			reader = next;
+		}
+	}
+
+	void disconnect_lagging() {
+		auto subscriber = subscribers_.front();
+		while (subscriber) {
+			auto next = subscriber->next_;
+			if (tail_ - subscriber->cursor_ >= capacity_) {
+				subscribers_.remove(subscriber);
+				subscriber->disconnected_.store(true, std::memory_order_relaxed);
+			}
+			subscriber = next;
+		}
+
+		min_cursor_ = 0;
+	}
+
+	// 订阅者读取后，kBlock 策略下挂起的写方可能可以继续
+	void release_writers(std::vector<Reader*>& readers,
+	                     std::vector<Writer*>& writers) {
+		if (policy_ != BroadcastPolicy::kBlock)
+			return;
+
+		while (!writer_list_.empty() && !full()) {
+			auto writer = writer_list_.pop_front();
+			publish(std::move(writer->value_), readers);
+			writers.push_back(writer);
+		}
+	}
+
+	// 被唤醒的节点已移出等待链表（链接已清空），以指针数组暂存，锁外逐个恢复
+	// 不使用另一个侵入式链表，恢复期间其他协程销毁暂存的节点不会破坏等待链表
+	template <typename Node> static void resume_all(std::vector<Node*>& nodes) {
+		for (auto node : nodes) {
+			node->resume();
+		}
+		nodes.clear();
+	}
+
+private:
+	BroadcastPolicy policy_{};
+
+	std::size_t capacity_{};
+	std::vector<Value> slots_;
+	std::size_t mask_{};
+	std::uint64_t tail_{};       // 下一个写入值的序号
+	std::uint64_t min_cursor_{}; // 最慢订阅者读取位置的下界
+
+	IntrusiveList<Subscriber> subscribers_{};
+	IntrusiveList<Writer> writer_list_{};
+	IntrusiveList<Reader> reader_list_{};
+
+	std::atomic<bool> is_active_{};
+	std::mutex mutex_{};
+};
+
+GOCOROUTINE_NAMESPACE_END
+
+#endif
@@ -2,29 +2,69 @@
 #define GOCOROUTINE_CHANNEL_H
 
 #include "gocoroutine/channel_awaiter.h"
+#include "gocoroutine/intrusive_list.h"
+#include "gocoroutine/ring_buffer.h"
+#include "gocoroutine/segmented_buffer.h"
 #include "gocoroutine/utils.h"
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <exception>
-#include <list>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
+#include <span>
 #include <utility>
+#include <vector>
 
 GOCOROUTINE_NAMESPACE_BEGIN
 
-template <typename T> class Channel {
+// 协程 channel，参考 Go 中的 channel
+// capacity 为 0 时为无缓冲 channel，读写双方直接交接，全部操作在锁内完成
+// 有缓冲时使用预分配的无锁环形队列 Buffer（缓冲的元素个数恰为 capacity），缓冲区未满时写入、
+// 非空时读取均不加锁；仅在需要挂起或存在挂起的读写方时才加锁
+// Buffer 声明 kUnbounded 时为无界 channel（见 UnboundedChannel），写入从不挂起，
+// 此时 capacity 作为分段大小传给 Buffer
+//
+// 挂起计数 parked_count_ 与缓冲区之间采用 Dekker 式检查：挂起方在锁内先增加计数再
+// 重新检查缓冲区，无锁的读写方先修改缓冲区再检查计数，二者之间均有 seq_cst fence，
+// 保证至少一方能看到对方，不会出现缓冲区有数据而读方一直挂起的情况
+//
+// 等待链表中的节点可能属于某个 select，取出节点时需先认领，认领失败说明该 select
+// 已由其他分支完成，直接丢弃节点即可
+//
+// 关闭语义与 Go 相同：关闭后写入抛出 ChannelClosedException，缓冲区中已写入的数据
+// 仍可被读取，读完后 read 抛出异常、read_optional 返回 std::nullopt
+// 关闭以 release 语义发布，读方观察到关闭时也能看到关闭前写入缓冲区的全部数据
+template <typename T, typename Buffer> class Channel {
 public:
-	class ChannelClosedException : std::exception {
+	class ChannelClosedException : public std::exception {
 	public:
 		const char* what() const noexcept override { /* NOLINT */
 			return "Channel is closed";
 		}
 	};
 
+	using value_type = T;
+	using Writer = WriterAwaiter<T, Channel>;
+	using Reader = ReaderAwaiter<T, Channel>;
+	using OptionalReader = OptionalReaderAwaiter<T, Channel>;
+	using TargetReader = TargetReaderAwaiter<T, Channel>;
+	using ResultReader = ResultReaderAwaiter<T, Channel>;
+	using ResultWriter = ResultWriterAwaiter<T, Channel>;
+	using BatchWriter = WriteBatchAwaiter<T, Channel>;
+	using BatchReader = ReadBatchAwaiter<T, Channel>;
+	using Range = ChannelRange<T, Channel>;
+
+	static constexpr std::size_t kDefaultRangeBatchSize = 64;
+
 public:
 	explicit Channel(int capacity = 0)
 	    : buffer_capacity_(capacity) {
+		if (capacity > 0 || kUnbounded) {
+			buffer_ = std::make_unique<Buffer>(capacity);
+		}
+
 		is_active_.store(true, std::memory_order_relaxed);
 	}
 
@@ -36,149 +76,551 @@ public:
 	Channel(Channel&& cahnnel) = delete;
 
 public:
-	bool is_active() { return is_active_.load(std::memory_order_relaxed); }
+	bool is_active() { return is_active_.load(std::memory_order_acquire); }
+
+	// 底层缓冲区，无缓冲时为空，用于读取 high_water_mark() 等统计信息
+	const Buffer* buffer() const { return buffer_.get(); }
 
 	void check_closed() {
-		if (!is_active_.load(std::memory_order_relaxed)) {
+		if (!is_active()) {
 			throw ChannelClosedException();
 		}
 	}
 
-	WriterAwaiter<T> write(T value) {
+	Writer write(T value) {
 		check_closed();
-		return WriterAwaiter<T>(this, value);
+		return Writer(this, std::move(value));
+	}
+
+	// 关闭后仍可读取缓冲区中剩余的数据，读完后抛出异常
+	Reader read() { return Reader(this); }
+
+	// 同 read，关闭且读完后返回 std::nullopt 而不抛出异常，适合作为消费循环的退出条件
+	OptionalReader read_optional() { return OptionalReader(this); }
+
+	// 不使用异常的读写，关闭时分别返回 status() 为 kClosed 的 ChannelResult 及 kClosed
+	ResultReader read_result() { return ResultReader(this); }
+	ResultWriter write_result(T value) {
+		return ResultWriter(this, std::move(value));
 	}
 
-	ReaderAwaiter<T> read() {
+	// 批量写入，co_await 返回写入的数量：至少写入一个，之后不挂起地写入尽可能多的元素
+	// 元素从 values 中移出，调用方按返回值推进直至全部写入
+	BatchWriter write_batch(std::span<T> values) {
 		check_closed();
-		return ReaderAwaiter<T>(this);
+		return BatchWriter(this, values);
 	}
 
-	WriterAwaiter<T> operator<<(T value) { return write(value); }
+	// 批量读取，co_await 返回至少一个、至多 max_count 个元素
+	BatchReader read_batch(std::size_t max_count) {
+		return BatchReader(this, max_count);
+	}
+
+	// 异步迭代，替代 while (is_active()) + try/catch 的消费循环
+	// 每次从 channel 拉取至多 batch_size 个值，摊薄加锁与唤醒的开销
+	Range range(std::size_t batch_size = kDefaultRangeBatchSize) {
+		return Range(this, batch_size);
+	}
 
-	ReaderAwaiter<T> operator>>(T& value_ref) {
+	Writer operator<<(T value) { return write(std::move(value)); }
 
-		auto awaiter = read();
-		awaiter.p_value_ = &value_ref;
-		return awaiter;
+	TargetReader operator>>(T& value_ref) {
+		return TargetReader(this, &value_ref);
 	}
 
 	void close() {
 
 		bool expect = true;
 		if (is_active_.compare_exchange_strong(expect, false,
-		                                       std::memory_order_relaxed)) {
+		                                       std::memory_order_acq_rel)) {
 			clean_up();
 		}
 	}
 
+	// 非阻塞读取，无可读数据时返回 std::nullopt，channel 已关闭且读完时抛出异常
+	// 有缓冲时无锁读取；无缓冲时仅在存在挂起的写方时加锁交接
+	std::optional<T> try_read() {
+		if (auto value = try_take())
+			return value;
+
+		check_closed();
+		return std::nullopt;
+	}
+
+	// 非阻塞写入，缓冲区已满或没有等待的读方时返回 false，此时 value 保持不变
+	bool try_write(T&& value) {
+		check_closed();
+		return try_give(value);
+	}
+
+	bool try_write(const T& value) {
+		T copy(value);
+		return try_write(std::move(copy));
+	}
+
 public:
-	void try_push_reader(ReaderAwaiter<T>* reader) {
+	// awaiter 的 await_ready 调用，无需挂起即可完成（含 channel 已关闭）时返回 true
+	// 关闭时设置 closed_，由 awaiter 决定抛出异常或返回空值
+	bool try_ready_reader(Reader* reader) {
+		if (try_read_into(reader))
+			return true;
+
+		if (!is_active()) {
+			reader->closed_ = true;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool try_ready_writer(Writer* writer) {
+		if (!is_active()) {
+			writer->closed_ = true;
+			return true;
+		}
+
+		return try_give(writer->value_);
+	}
+
+	// 不挂起地读取一个值交给 reader，返回是否读到
+	bool try_read_into(Reader* reader) {
+		auto value = try_take();
+		if (!value)
+			return false;
+
+		reader->resume(std::move(*value));
+		return true;
+	}
+
+	// 不挂起地取出至多 max_count 个值追加至 values，返回取出的数量
+	// 有缓冲时无锁读取后统一唤醒一次；无缓冲时在一次加锁内取出所有可交接的写方
+	// 取出的节点链接已清空，暂存于 vector 而非另一个侵入式链表，锁外恢复期间
+	// 其他协程销毁挂起的 awaiter 时 remove_* 不会受到影响
+	std::size_t try_take_batch(std::vector<T>& values, std::size_t max_count) {
+		std::size_t count = 0;
+
+		if (buffer_) {
+			while (count < max_count) {
+				auto value = buffer_->try_pop();
+				if (!value)
+					break;
+
+				values.push_back(std::move(*value));
+				++count;
+			}
+
+			if (count > 0) {
+				notify_parked();
+			}
+			return count;
+		}
+
+		if (parked_count_.load(std::memory_order_relaxed) == 0)
+			return 0;
+
+		std::vector<Writer*> writers;
+		{
+			std::lock_guard<std::mutex> lk(channel_mutex_);
+			while (count < max_count) {
+				auto writer = pop_claimed(writer_list_);
+				if (!writer)
+					break;
+
+				writers.push_back(writer);
+				++count;
+			}
+		}
+
+		for (auto writer : writers) {
+			values.push_back(std::move(writer->value_));
+			writer->resume();
+		}
+		return count;
+	}
+
+	// 不挂起地写入 values 的前缀，返回写入的数量，未写入的元素保持不变
+	// channel 已关闭时不再写入，批量写入恢复后的补充写入据此返回部分写入的数量
+	// 无缓冲时取出的读方同 try_take_batch 暂存于 vector
+	std::size_t try_give_batch(std::span<T> values) {
+		std::size_t count = 0;
+		if (!is_active())
+			return count;
+
+		if (buffer_) {
+			while (count < values.size() &&
+			       buffer_->try_push(std::move(values[count]))) {
+				++count;
+			}
+
+			if (count > 0) {
+				notify_parked();
+			}
+			return count;
+		}
+
+		if (parked_count_.load(std::memory_order_relaxed) == 0)
+			return 0;
+
+		std::vector<Reader*> readers;
+		{
+			std::lock_guard<std::mutex> lk(channel_mutex_);
+			while (count < values.size()) {
+				auto reader = pop_claimed(reader_list_);
+				if (!reader)
+					break;
+
+				readers.push_back(reader);
+				++count;
+			}
+		}
+
+		for (std::size_t i = 0; i < readers.size(); ++i) {
+			readers[i]->resume(std::move(values[i]));
+			readers[i]->resume();
+		}
+		return count;
+	}
+
+	// awaiter 的 await_suspend 调用，挂起时返回 true，否则由 await_resume 继续
+	// 无锁的快速路径已在 await_ready 中尝试过，这里直接加锁
+	bool try_push_reader(Reader* reader) {
+
 		std::unique_lock<std::mutex> lk(channel_mutex_);
-		check_closed();
+		if (!is_active()) {
+			reader->closed_ = true;
+			return false;
+		}
 
-		if (!buffer_.empty()) {
-			auto value = buffer_.front();
-			buffer_.pop();
+		if (buffer_) {
 
-			if (!writer_list_.empty()) {
-				auto writer = writer_list_.front();
-				writer_list_.pop_front();
-				buffer_.push(writer->value_);
-				lk.unlock();
-				writer->resume();
-			} else {
+			// 先增加挂起计数再重新检查，与写方的 notify_parked 配对
+			parked_count_.fetch_add(1, std::memory_order_seq_cst);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (auto value = buffer_->try_pop()) {
+				parked_count_.fetch_sub(1, std::memory_order_relaxed);
 				lk.unlock();
+
+				reader->resume(std::move(*value));
+				notify_parked();
+				return false;
 			}
 
-			reader->resume(value);
-            return;
+			reader_list_.push_back(reader);
+			return true;
 		}
 
-        if (!writer_list_.empty()) {
-            auto writer = writer_list_.front();
-            writer_list_.pop_front();
-            lk.unlock();
+		if (auto writer = pop_claimed(writer_list_)) {
+			lk.unlock();
 
-            reader->resume(writer->value_);
-            writer->resume();
-            return;
-        }
+			reader->resume(std::move(writer->value_));
+			writer->resume();
+			return false;
+		}
 
+		parked_count_.fetch_add(1, std::memory_order_relaxed);
+		reader_list_.push_back(reader);
+		return true;
 	}
 
-	void try_push_writer(WriterAwaiter<T>* writer) {
-        std::unique_lock<std::mutex> lk(channel_mutex_);
-        check_closed();
+	bool try_push_writer(Writer* writer) {
+
+		std::unique_lock<std::mutex> lk(channel_mutex_);
+		if (!is_active()) {
+			writer->closed_ = true;
+			return false;
+		}
+
+		if (buffer_) {
+			parked_count_.fetch_add(1, std::memory_order_seq_cst);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
 
-        if(!reader_list_.empty()) {
-            auto reader = reader_list_.front();
-            reader_list_.pop_front();
-            lk.unlock();
+			if (buffer_->try_push(std::move(writer->value_))) {
+				parked_count_.fetch_sub(1, std::memory_order_relaxed);
+				lk.unlock();
 
-            reader->resume(writer->value_);
-            writer->resume();
-            return;
-        }
+				notify_parked();
+				return false;
+			}
 
-        if(buffer_.size() < buffer_capacity_) {
-            buffer_.push(writer->value_);
-            lk.unlock();
-            writer->resume();
-            return;
-        }
+			writer_list_.push_back(writer);
+			return true;
+		}
 
-        writer_list_.push_back(writer);
+		if (auto reader = pop_claimed(reader_list_)) {
+			lk.unlock();
 
-    }
+			reader->resume(std::move(writer->value_));
+			reader->resume();
+			return false;
+		}
 
-	void remove_reader(ReaderAwaiter<T>* reader) {
+		parked_count_.fetch_add(1, std::memory_order_relaxed);
+		writer_list_.push_back(writer);
+		return true;
+	}
+
+	// 挂起的协程被销毁时由 awaiter 析构调用，O(1) 移出等待链表
+	void remove_reader(Reader* reader) {
 		std::unique_lock<std::mutex> lk(channel_mutex_);
 
-		auto size = reader_list_.remove(reader);
-		DEBUGFMTLOG("remove_reader: size = {}", size);
+		if (reader_list_.contains(reader)) {
+			reader_list_.remove(reader);
+			parked_count_.fetch_sub(1, std::memory_order_relaxed);
+			DEBUGFMTLOG("remove_reader: size = {}", reader_list_.size());
+		}
 	}
 
-	void remove_writer(WriterAwaiter<T>* writer) {
+	void remove_writer(Writer* writer) {
 
 		std::unique_lock<std::mutex> lk(channel_mutex_);
 
-		auto size = writer_list_.remove(writer);
-		DEBUGFMTLOG("remove_writer: size = {}", size);
+		if (writer_list_.contains(writer)) {
+			writer_list_.remove(writer);
+			parked_count_.fetch_sub(1, std::memory_order_relaxed);
+			DEBUGFMTLOG("remove_writer: size = {}", writer_list_.size());
+		}
+	}
+
+public:
+	// 以下供 select 使用，select 按地址顺序持有所有相关 channel 的锁后依次调用：
+	// select_prepare -> select_read/select_write -> select_park_* 或 select_cancel_prepare
+	// prepare 预先增加挂起计数，与无锁读写方的 notify_parked 配对，语义同 try_push_reader
+	std::mutex& select_mutex() { return channel_mutex_; }
+
+	void select_prepare() {
+		parked_count_.fetch_add(1, std::memory_order_seq_cst);
+	}
+
+	void select_cancel_prepare() {
+		parked_count_.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	// 可立即完成（含 channel 已关闭）时返回 true，无缓冲时交接的写方通过 partner
+	// 返回，由调用方在释放锁后恢复
+	bool select_read(Reader* reader, Writer*& partner) {
+		if (buffer_) {
+			if (auto value = buffer_->try_pop()) {
+				reader->resume(std::move(*value));
+				return true;
+			}
+		} else if ((partner = pop_claimed(writer_list_))) {
+			reader->resume(std::move(partner->value_));
+			return true;
+		}
+
+		if (!is_active()) {
+			reader->closed_ = true;
+			return true;
+		}
+
+		return false;
+	}
+
+	bool select_write(Writer* writer, Reader*& partner) {
+		if (!is_active()) {
+			writer->closed_ = true;
+			return true;
+		}
+
+		if (buffer_)
+			return buffer_->try_push(std::move(writer->value_));
+
+		partner = pop_claimed(reader_list_);
+		if (!partner)
+			return false;
+
+		partner->resume(std::move(writer->value_));
+		return true;
+	}
+
+	// 挂起计数已由 select_prepare 增加
+	void select_park_reader(Reader* reader) { reader_list_.push_back(reader); }
+	void select_park_writer(Writer* writer) { writer_list_.push_back(writer); }
+
+	// select 释放锁后调用，有缓冲时缓冲区的变化可能使挂起的读写方可以继续
+	void select_notify() {
+		if (buffer_) {
+			notify_parked();
+		}
 	}
 
 private:
+	// 不挂起地取出一个值：有缓冲时无锁读取，无缓冲时与挂起的写方交接
+	// 挂起计数为 0 时不加锁，与并发挂起的写方竞争失败视为暂无数据
+	std::optional<T> try_take() {
+		if (buffer_) {
+			auto value = buffer_->try_pop();
+			if (value) {
+				notify_parked();
+			}
+			return value;
+		}
+
+		if (parked_count_.load(std::memory_order_relaxed) == 0)
+			return std::nullopt;
+
+		std::unique_lock<std::mutex> lk(channel_mutex_);
+		auto writer = pop_claimed(writer_list_);
+		if (!writer)
+			return std::nullopt;
+
+		lk.unlock();
+		std::optional<T> value(std::move(writer->value_));
+		writer->resume();
+		return value;
+	}
+
+	// 不挂起地写入一个值，失败时 value 保持不变
+	bool try_give(T& value) {
+		if (buffer_) {
+			if (!buffer_->try_push(std::move(value)))
+				return false;
+
+			notify_parked();
+			return true;
+		}
+
+		if (parked_count_.load(std::memory_order_relaxed) == 0)
+			return false;
+
+		std::unique_lock<std::mutex> lk(channel_mutex_);
+		auto reader = pop_claimed(reader_list_);
+		if (!reader)
+			return false;
+
+		lk.unlock();
+		reader->resume(std::move(value));
+		reader->resume();
+		return true;
+	}
+
+	// 在锁内取出第一个可认领的节点，已被其他分支认领的 select 节点直接丢弃
+	template <typename Node> Node* pop_claimed(IntrusiveList<Node>& list) {
+		while (auto node = list.pop_front()) {
+			parked_count_.fetch_sub(1, std::memory_order_relaxed);
+			if (node->try_claim())
+				return node;
+		}
+
+		return nullptr;
+	}
+
+	// 缓冲区发生变化后调用，存在挂起的读写方时加锁处理
+	void notify_parked() {
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (parked_count_.load(std::memory_order_relaxed) > 0) {
+			balance();
+		}
+	}
+
+	// 将缓冲区中的数据交给挂起的读方，将挂起写方的数据写入缓冲区
+	// 每次仅处理一个挂起方，恢复前释放锁
+	// 对队首节点先 acquire 再操作缓冲区，成功则 commit，缓冲区为空/满则 release，
+	// acquire 失败说明所属 select 已完成，丢弃后继续
+	void balance() {
+		std::unique_lock<std::mutex> lk(channel_mutex_);
+
+		while (true) {
+			if (auto reader = reader_list_.front()) {
+				if (!reader->acquire()) {
+					drop(reader_list_);
+					continue;
+				}
+
+				if (auto value = buffer_->try_pop()) {
+					reader->commit();
+					drop(reader_list_);
+					lk.unlock();
+
+					reader->resume(std::move(*value));
+					reader->resume();
+					lk.lock();
+					continue;
+				}
+
+				reader->release();
+			}
+
+			if (auto writer = writer_list_.front()) {
+				if (!writer->acquire()) {
+					drop(writer_list_);
+					continue;
+				}
+
+				if (buffer_->try_push(std::move(writer->value_))) {
+					writer->commit();
+					drop(writer_list_);
+					lk.unlock();
+
+					writer->resume();
+					lk.lock();
+					continue;
+				}
+
+				writer->release();
+			}
+
+			break;
+		}
+	}
+
+	template <typename Node> void drop(IntrusiveList<Node>& list) {
+		list.pop_front();
+		parked_count_.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	// 唤醒所有挂起的读写方并标记为因关闭结束，读方恢复后继续读取缓冲区中剩余的数据
+	// 逐个在锁内取出、锁外恢复，避免恢复的协程再次操作 channel 时死锁，
+	// 同时保证节点不会出现在 channel 之外的链表中，remove_* 的判断始终有效
 	void clean_up() {
 
 		std::unique_lock<std::mutex> lk(channel_mutex_);
 
 		// 释放所有 writer
-		for (auto writer : writer_list_) {
+		while (auto writer = pop_claimed(writer_list_)) {
+			writer->closed_ = true;
+			lk.unlock();
 			writer->resume();
+			lk.lock();
 		}
-		writer_list_.clear();
 
 		// 释放所有 reader
-		for (auto reader : reader_list_) {
+		while (auto reader = pop_claimed(reader_list_)) {
+			reader->closed_ = true;
+			lk.unlock();
 			reader->resume();
+			lk.lock();
 		}
-		reader_list_.clear();
 
-		std::exchange(buffer_, {});
+		parked_count_.store(0, std::memory_order_relaxed);
 	}
 
 private:
+	static constexpr bool kUnbounded = requires { requires Buffer::kUnbounded; };
+
 	int buffer_capacity_{};
-	std::queue<T> buffer_{};
+	std::unique_ptr<Buffer> buffer_{};
+
+	// 侵入式等待链表，节点为挂起协程帧中的 awaiter
+	IntrusiveList<Writer> writer_list_{};
+	IntrusiveList<Reader> reader_list_{};
 
-	std::list<WriterAwaiter<T>*> writer_list_{};
-	std::list<ReaderAwaiter<T>*> reader_list_{};
+	// 挂起的读写方数量，有缓冲时无锁路径据此判断是否需要加锁
+	std::atomic<std::size_t> parked_count_{};
 
 	std::atomic<bool> is_active_{};
 	std::mutex channel_mutex_{};
 	std::condition_variable channel_condition_{};
 };
 
+// 单生产者单消费者 channel，同一时刻至多一个写协程及一个读协程
+template <typename T> using SpscChannel = Channel<T, SpscRingBuffer<T>>;
+
+// 无界 channel，由定长分段组成的队列作为缓冲区，写入从不挂起
+// 构造参数为分段大小，为 0 时使用 SegmentedBuffer::kDefaultSegmentSize
+template <typename T> using UnboundedChannel = Channel<T, SegmentedBuffer<T>>;
+
 GOCOROUTINE_NAMESPACE_END
 
-#endif
\ No newline at end of file
+#endif
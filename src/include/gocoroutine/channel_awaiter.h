@@ -2,25 +2,150 @@
 #define GOCOROUTINE_CHANNEL_AWAITER_H
 
 #include "gocoroutine/executor.h"
+#include "gocoroutine/intrusive_list.h"
+#include "gocoroutine/ring_buffer.h"
 #include "gocoroutine/utils.h"
+#include <algorithm>
+#include <atomic>
 #include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <thread>
 #include <utility>
+#include <vector>
 
 GOCOROUTINE_NAMESPACE_BEGIN
 
-template <typename T> class Channel;
+template <typename T, typename Buffer = MpmcRingBuffer<T>> class Channel;
 
-template <typename T> class WriterAwaiter {
+// select 认领状态，同一个 select 挂起在多个 channel 上的 awaiter 共享
+// 各 channel 在各自的锁内通过 CAS 认领，保证只有一个分支被选中
+// 认领分为两个阶段：acquire 将状态置为 kBusy，此时其他认领方自旋等待，
+// 持有方确认可以完成后 commit，否则 release 恢复为 kFree
+// channel 在自身锁内认领，kBusy 期间不会等待任何 channel 锁，避免与持锁自旋的认领方死锁
+// 唯一的例外是 SelectAwaiter::await_suspend 登记超时定时器时，持有 kBusy 获取定时器所在
+// 执行器或 Scheduler 的锁（ExecutorTimers 的锁、ThreadPoolExecutor 的 queue_mutex_、
+// GolangExecutor 的 idle_mutex_ 或 Scheduler 的锁）。此时尚无节点挂入 channel，
+// 可能自旋的只有刚登记的超时回调，而这些锁在执行定时回调时均已释放，因此不会死锁
+class SelectClaim {
 
 public:
-	WriterAwaiter(Channel<T>* channel, T value)
+	static constexpr int kFree = -1;
+	static constexpr int kBusy = -2;
+
+public:
+	bool acquire() {
+		while (true) {
+			int expected = kFree;
+			if (state_.compare_exchange_weak(expected, kBusy,
+			                                 std::memory_order_acquire))
+				return true;
+
+			if (expected != kBusy && expected != kFree)
+				return false;
+
+			std::this_thread::yield();
+		}
+	}
+
+	void commit(int index) { state_.store(index, std::memory_order_release); }
+	void release() { state_.store(kFree, std::memory_order_release); }
+
+	bool try_claim(int index) {
+		if (!acquire())
+			return false;
+
+		commit(index);
+		return true;
+	}
+
+	// 被选中的分支序号，未选中时为负数
+	int index() const { return state_.load(std::memory_order_acquire); }
+
+	// 超时等非 channel 分支被选中时恢复 select 所在协程
+	void resume() {
+		if (executor_) {
+			executor_->schedule(handle_);
+		} else {
+			handle_.resume();
+		}
+	}
+
+public:
+	std::coroutine_handle<> handle_{};
+	AbstractExecutor* executor_{};
+
+private:
+	std::atomic<int> state_{kFree};
+};
+
+// channel 等待链表节点的 select 认领部分
+// 普通读写的 awaiter 不属于任何 select，claim_ 为空，认领总是成功
+class SelectNode {
+public:
+	bool acquire() { return !claim_ || claim_->acquire(); }
+
+	void commit() {
+		if (claim_)
+			claim_->commit(case_index_);
+	}
+
+	void release() {
+		if (claim_)
+			claim_->release();
+	}
+
+	bool try_claim() { return !claim_ || claim_->try_claim(case_index_); }
+
+public:
+	SelectClaim* claim_{};
+	int case_index_{};
+};
+
+// channel 操作状态，以返回值而非异常表示 channel 已关闭
+enum class ChannelStatus {
+	kOk,     // 读写成功
+	kClosed, // channel 已关闭（读取时缓冲区已读完）
+};
+
+// channel 读取结果，关闭时不抛出异常，消费循环结束只需一次分支判断
+template <typename T> class ChannelResult {
+
+public:
+	ChannelResult() = default;
+
+	explicit ChannelResult(T&& value)
+	    : status_(ChannelStatus::kOk)
+	    , value_(std::move(value)) {}
+
+public:
+	ChannelStatus status() const { return status_; }
+	bool ok() const { return status_ == ChannelStatus::kOk; }
+	explicit operator bool() const { return ok(); }
+
+	// 仅在 ok() 时有效
+	T& value() & { return *value_; }
+	T&& value() && { return std::move(*value_); }
+
+private:
+	ChannelStatus status_{ChannelStatus::kClosed};
+	std::optional<T> value_{};
+};
+
+// Channel_ 为所属 channel 类型，不同缓冲区实现的 channel 共用同一套 awaiter
+template <typename T, typename Channel_ = Channel<T>> class WriterAwaiter : public SelectNode {
+
+public:
+	// 值在整个传递过程中均为移动，支持 std::unique_ptr 等仅可移动类型
+	WriterAwaiter(Channel_* channel, T value)
 	    : channel_(channel)
-	    , value_(value) {}
+	    , value_(std::move(value)) {}
 
 	WriterAwaiter(WriterAwaiter&& other) noexcept
 	    : channel_(std::exchange(other.channel_, {}))
 	    , executor_(std::exchange(other.executor_, {}))
-	    , value_(other.value_)
+	    , value_(std::move(other.value_))
 	    , handle_(other.handle_) {}
 
 	~WriterAwaiter() {
@@ -30,43 +155,54 @@ public:
 	}
 
 public:
-	constexpr bool await_ready() { return false; }
+	// 缓冲区未满或有等待的读方时直接完成，不经过执行器调度
+	bool await_ready() { return channel_->try_ready_writer(this); }
 
-	void await_suspend(std::coroutine_handle<> handle) noexcept {
+	bool await_suspend(std::coroutine_handle<> handle) {
 
 		this->handle_ = handle;
-		channel_->try_push_writer(this);
+		return channel_->try_push_writer(this);
 	}
 
+	// 写入前 channel 已关闭时抛出异常，写入成功后关闭不影响本次写入
 	void await_resume() {
-		channel_->check_closed();
-		channel_ = nullptr;
+		auto channel = std::exchange(channel_, nullptr);
+		if (closed_)
+			channel->check_closed();
 	}
 
 	void resume() {
 		if (executor_) {
-			executor_->execute([this]() { handle_.resume(); });
+			executor_->schedule(handle_);
 		} else {
 			handle_.resume();
 		}
 	}
 
 public:
-	Channel<T>* channel_{};
+	Channel_* channel_{};
 	AbstractExecutor* executor_{};
-	T value_{};
+	T value_;
 	std::coroutine_handle<> handle_{};
+
+	// 因 channel 关闭而结束等待，由 channel 设置
+	bool closed_{};
+
+	// 挂起时链入 channel 的等待链表，awaiter 位于协程帧中，挂起不进行内存分配
+	WriterAwaiter* prev_{};
+	WriterAwaiter* next_{};
+	IntrusiveList<WriterAwaiter>* list_{};
 };
 
-template <typename T> class ReaderAwaiter {
+template <typename T, typename Channel_ = Channel<T>> class ReaderAwaiter : public SelectNode {
 public:
-	explicit ReaderAwaiter(Channel<T>* channel)
+	explicit ReaderAwaiter(Channel_* channel)
 	    : channel_(channel) {}
 
 	ReaderAwaiter(ReaderAwaiter&& other) noexcept
 	    : channel_(std::exchange(other.channel_, {}))
 	    , executor_(std::exchange(other.executor_, {}))
-	    , value_(other.value_)
+	    , value_(std::move(other.value_))
 	    , p_value_(std::exchange(other.p_value_, {}))
 	    , handle_(other.handle_) {}
 
@@ -77,41 +213,343 @@ public:
 	}
 
 public:
-	bool await_ready() { return false; }
+	// 缓冲区有数据或有等待的写方时直接完成，不经过执行器调度
+	bool await_ready() { return channel_->try_ready_reader(this); }
 
-	auto await_suspend(std::coroutine_handle<> handle) {
+	bool await_suspend(std::coroutine_handle<> handle) {
 		this->handle_ = handle;
-		channel_->try_push_reader(this);
+		return channel_->try_push_reader(this);
 	}
 
-	int await_resume() {
+	// channel 关闭且缓冲区已读完时抛出异常
+	T await_resume() {
 		auto channel = this->channel_;
-		this->channel_ = nullptr;
-		channel->check_closed();
-		return value_;
+		if (!complete())
+			channel->check_closed();
+
+		return std::move(*value_);
 	}
 
-    void resume(T value) {
-        this->value_ = value;
-        if(p_value_) {
-            *p_value_ = value;
-        }
-    }
+	// 结束读取，返回是否读到值
+	// 因 channel 关闭而被唤醒时缓冲区中可能仍有数据，先继续读取
+	bool complete() {
+		auto channel = std::exchange(channel_, nullptr);
+		return !closed_ || channel->try_read_into(this);
+	}
+
+	// 设置了 p_value_（operator>> 及 select）时直接移动至目标变量，
+	// 否则暂存至 value_ 由 await_resume 返回
+	void resume(T&& value) {
+		if (p_value_) {
+			*p_value_ = std::move(value);
+		} else {
+			value_.emplace(std::move(value));
+		}
+	}
 
     void resume() {
         if(executor_) {
-            executor_->execute([this]() { handle_.resume(); });
+            executor_->schedule(handle_);
         } else {
             handle_.resume();
         }
     }
 
 public:
-	Channel<T>* channel_{};
+	Channel_* channel_{};
 	AbstractExecutor* executor_{};
-	T value_{};
+	// 读到值时才构造，T 无需默认构造
+	std::optional<T> value_{};
 	T* p_value_{};
 	std::coroutine_handle<> handle_{};
+	bool closed_{};
+
+	ReaderAwaiter* prev_{};
+	ReaderAwaiter* next_{};
+	IntrusiveList<ReaderAwaiter>* list_{};
+};
+
+// 不抛出异常的读取，channel 关闭且缓冲区已读完时返回 std::nullopt
+template <typename T, typename Channel_ = Channel<T>>
+class OptionalReaderAwaiter : public ReaderAwaiter<T, Channel_> {
+public:
+	using ReaderAwaiter<T, Channel_>::ReaderAwaiter;
+
+public:
+	std::optional<T> await_resume() {
+		if (!this->complete())
+			return std::nullopt;
+
+		return std::move(this->value_);
+	}
+};
+
+// operator>> 的读取，值直接移动至目标变量，await_resume 不返回值
+// value_ 始终为空，不能沿用 ReaderAwaiter::await_resume
+template <typename T, typename Channel_ = Channel<T>>
+class TargetReaderAwaiter : public ReaderAwaiter<T, Channel_> {
+public:
+	TargetReaderAwaiter(Channel_* channel, T* target)
+	    : ReaderAwaiter<T, Channel_>(channel) {
+		this->p_value_ = target;
+	}
+
+public:
+	// channel 关闭且缓冲区已读完时抛出异常
+	void await_resume() {
+		auto channel = this->channel_;
+		if (!this->complete())
+			channel->check_closed();
+	}
+};
+
+// 不抛出异常的读取，返回 ChannelResult
+template <typename T, typename Channel_ = Channel<T>>
+class ResultReaderAwaiter : public ReaderAwaiter<T, Channel_> {
+public:
+	using ReaderAwaiter<T, Channel_>::ReaderAwaiter;
+
+public:
+	ChannelResult<T> await_resume() {
+		if (!this->complete())
+			return ChannelResult<T>();
+
+		return ChannelResult<T>(std::move(*this->value_));
+	}
+};
+
+// 不抛出异常的写入，返回 ChannelStatus
+template <typename T, typename Channel_ = Channel<T>>
+class ResultWriterAwaiter : public WriterAwaiter<T, Channel_> {
+public:
+	using WriterAwaiter<T, Channel_>::WriterAwaiter;
+
+public:
+	ChannelStatus await_resume() {
+		this->channel_ = nullptr;
+		return this->closed_ ? ChannelStatus::kClosed : ChannelStatus::kOk;
+	}
+};
+
+// 批量写入，先不挂起地写入尽可能多的元素，一个都无法写入时以第一个元素挂起，
+// 恢复后再不挂起地继续写入，await_resume 返回写入的数量
+template <typename T, typename Channel_ = Channel<T>> class WriteBatchAwaiter {
+
+public:
+	using Writer = WriterAwaiter<T, Channel_>;
+
+	WriteBatchAwaiter(Channel_* channel, std::span<T> values)
+	    : channel_(channel)
+	    , values_(values) {}
+
+public:
+	bool await_ready() {
+		if (values_.empty())
+			return true;
+
+		if (!channel_->is_active()) {
+			closed_ = true;
+			return true;
+		}
+
+		written_ = channel_->try_give_batch(values_);
+		return written_ > 0;
+	}
+
+	// 挂起时才以第一个元素构造写节点，T 无需默认构造
+	bool await_suspend(std::coroutine_handle<> handle) {
+		node_.emplace(channel_, std::move(values_.front()));
+		node_->handle_ = handle;
+		node_->executor_ = executor_;
+		return channel_->try_push_writer(&*node_);
+	}
+
+	std::size_t await_resume() {
+		if (node_) {
+			node_->channel_ = nullptr;
+			closed_ = node_->closed_;
+		}
+
+		if (closed_) {
+			if (node_) {
+				// 未写入的元素归还给调用方
+				values_.front() = std::move(node_->value_);
+			}
+			channel_->check_closed();
+		}
+
+		if (node_) {
+			written_ = 1 + channel_->try_give_batch(values_.subspan(1));
+		}
+
+		return written_;
+	}
+
+public:
+	AbstractExecutor* executor_{};
+
+private:
+	Channel_* channel_{};
+	std::optional<Writer> node_{};
+	std::span<T> values_{};
+	std::size_t written_{};
+	bool closed_{};
+};
+
+// 批量读取，先不挂起地读取至多 max_count 个元素，一个都没有时挂起等待一个，
+// 恢复后再不挂起地补充读取，await_resume 返回读取到的元素
+template <typename T, typename Channel_ = Channel<T>> class ReadBatchAwaiter {
+
+public:
+	using Reader = ReaderAwaiter<T, Channel_>;
+
+	// storage 用于复用已分配的内存，读取前清空
+	ReadBatchAwaiter(Channel_* channel, std::size_t max_count,
+	                 std::vector<T> storage = {})
+	    : channel_(channel)
+	    , node_(channel)
+	    , max_count_(max_count)
+	    , values_(std::move(storage)) {
+		values_.clear();
+	}
+
+public:
+	bool await_ready() {
+		if (max_count_ == 0)
+			return true;
+
+		// 关闭后仍先读取缓冲区中剩余的数据，观察到关闭时由 complete 再读取一次
+		channel_->try_take_batch(values_, max_count_);
+		return !values_.empty() || !channel_->is_active();
+	}
+
+	bool await_suspend(std::coroutine_handle<> handle) {
+		node_.handle_ = handle;
+		node_.executor_ = executor_;
+		suspended_ = true;
+		return channel_->try_push_reader(&node_);
+	}
+
+	// channel 关闭且缓冲区已读完时抛出异常
+	std::vector<T> await_resume() {
+		if (!complete())
+			channel_->check_closed();
+
+		return std::move(values_);
+	}
+
+	// 结束读取，返回是否读到值，读到的值通过 take_values 取出
+	// 与 ReaderAwaiter::complete 相同，观察到关闭后缓冲区中可能仍有关闭前写入的数据，
+	// 未挂起时也需再读取一次
+	bool complete() {
+		if (suspended_) {
+			if (node_.complete()) {
+				values_.push_back(std::move(*node_.value_));
+				channel_->try_take_batch(values_, max_count_ - 1);
+			}
+		} else if (values_.empty() && max_count_ > 0) {
+			channel_->try_take_batch(values_, max_count_);
+		}
+		node_.channel_ = nullptr;
+
+		return !values_.empty() || max_count_ == 0;
+	}
+
+	std::vector<T> take_values() { return std::move(values_); }
+
+public:
+	AbstractExecutor* executor_{};
+
+private:
+	Channel_* channel_{};
+	Reader node_;
+	std::size_t max_count_{};
+	std::vector<T> values_{};
+	bool suspended_{};
+};
+
+template <typename T, typename Channel_> class ChannelRange;
+
+// ChannelRange::next 返回的 awaiter，本地批次读完后通过 ReadBatchAwaiter 拉取下一批
+template <typename T, typename Channel_ = Channel<T>> class RangeNextAwaiter {
+
+public:
+	explicit RangeNextAwaiter(ChannelRange<T, Channel_>* range)
+	    : range_(range) {}
+
+public:
+	bool await_ready() {
+		if (range_->advance())
+			return true;
+
+		batch_.emplace(range_->channel_, range_->batch_size_,
+		               std::move(range_->values_));
+		return batch_->await_ready();
+	}
+
+	bool await_suspend(std::coroutine_handle<> handle) {
+		batch_->executor_ = executor_;
+		return batch_->await_suspend(handle);
+	}
+
+	// 返回 false 表示 channel 已关闭且读完
+	bool await_resume() {
+		if (!batch_)
+			return true;
+
+		auto has_value = batch_->complete();
+		range_->reset(batch_->take_values());
+		return has_value;
+	}
+
+public:
+	AbstractExecutor* executor_{};
+
+private:
+	ChannelRange<T, Channel_>* range_{};
+	std::optional<ReadBatchAwaiter<T, Channel_>> batch_{};
+};
+
+// channel 的异步迭代，逐个返回值直至 channel 关闭且读完，不抛出异常
+// 内部每次至多拉取 batch_size 个值，本地批次读完前不访问 channel：
+//   auto range = channel.range();
+//   while (co_await range.next()) { use(range.value()); }
+template <typename T, typename Channel_ = Channel<T>> class ChannelRange {
+
+public:
+	ChannelRange(Channel_* channel, std::size_t batch_size)
+	    : channel_(channel)
+	    , batch_size_(std::max<std::size_t>(batch_size, 1)) {}
+
+public:
+	RangeNextAwaiter<T, Channel_> next() {
+		return RangeNextAwaiter<T, Channel_>(this);
+	}
+
+	// 当前值，仅在 next 返回 true 后有效
+	T& value() { return values_[current_]; }
+
+private:
+	friend class RangeNextAwaiter<T, Channel_>;
+
+	bool advance() {
+		if (current_ + 1 >= values_.size())
+			return false;
+
+		++current_;
+		return true;
+	}
+
+	void reset(std::vector<T> values) {
+		values_ = std::move(values);
+		current_ = 0;
+	}
+
+private:
+	Channel_* channel_{};
+	std::size_t batch_size_{};
+	std::vector<T> values_{};
+	std::size_t current_{};
 };
 
 GOCOROUTINE_NAMESPACE_END
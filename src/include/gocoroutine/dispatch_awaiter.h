@@ -18,8 +18,7 @@ public:
 	void await_suspend(std::coroutine_handle<> handle) const {
 
 		// 协程调度到对应的调度器上
-		executor_->execute([handle]() { 
-			handle.resume(); });
+		executor_->schedule(handle);
 	}
 
 	void await_resume() {}
@@ -1,14 +1,27 @@
 #ifndef GOCOROUTINE_EXECUTOR_H
 #define GOCOROUTINE_EXECUTOR_H
 
+#include "gocoroutine/executor_timers.h"
+#include "gocoroutine/intrusive_list.h"
+#include "gocoroutine/ring_buffer.h"
+#include "gocoroutine/scheduler.h"
+#include "gocoroutine/timing_wheel.h"
 #include "gocoroutine/utils.h"
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <future>
+#include <iterator>
+#include <memory>
 #include <mutex>
 #include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
 
 GOCOROUTINE_NAMESPACE_BEGIN
 
@@ -19,12 +32,37 @@ class AbstractExecutor {
 public:
 	// 调度函数，实现为纯虚函数
 	virtual void execute(std::function<void()>&& func) = 0;
+
+	// 协程恢复调度，默认包装为 func 交由 execute 执行
+	// 调度器可以重写该函数，直接记录协程句柄以避免构造 std::function
+	virtual void schedule(std::coroutine_handle<> handle) {
+		execute([handle]() { handle.resume(); });
+	}
+
+	// 协程延时恢复调度，默认由全局定时调度器到期后转交 schedule
+	// 调度器可以重写该函数，自行管理定时事件并在执行线程上直接恢复协程
+	virtual TimerHandle schedule_after(std::coroutine_handle<> handle,
+	                                   std::chrono::nanoseconds delay) {
+		return Scheduler::shared().execute([this, handle]() { schedule(handle); },
+		                                   delay);
+	}
+
+	// 延时执行 func，用于到期时需先做判断再恢复协程的场景（如 select 超时）
+	// func 在定时线程上执行，应只做轻量的判断及调度；默认使用全局定时调度器，
+	// 自行管理定时事件的调度器重写后在执行线程上执行
+	// 重写时不能在持有本函数所取的锁时执行 func：select 在持有认领时调用本函数，参见 SelectClaim
+	virtual TimerHandle execute_after(std::function<void()>&& func,
+	                                  std::chrono::nanoseconds delay) {
+		return Scheduler::shared().execute(std::move(func), delay);
+	}
 };
 
 // 这里调度器定义为无任何调度，直接执行 func 函数
 class NoopExecuter : public AbstractExecutor {
 public:
 	void execute(std::function<void()>&& func) override { func(); }
+
+	void schedule(std::coroutine_handle<> handle) override { handle.resume(); }
 };
 
 // 这里调度器定义为使用一个新建独立线程来运行
@@ -39,7 +77,8 @@ public:
 };
 
 // 这里调度器定义为采用 std::async 进行任务分配调度
-// 因为 std::async 内部维护线程池，可以减少每次创建新线程带来的开销
+// 注意 std::async 返回的 future 在析构时阻塞等待任务完成，因此 execute 实际为同步执行
+// 需要多线程并发执行时使用 ThreadPoolExecutor
 class AsyncExecutor : public AbstractExecutor {
 public:
 	void execute(std::function<void()>&& func) override {
@@ -54,7 +93,10 @@ class LooperExecutor : public AbstractExecutor {
 
 public:
 	// 设置循环执行标志，启动执行线程
-	LooperExecutor() {
+	// slack 为定时合并窗口，语义同 Scheduler，协程 co_await 延时即使用该窗口
+	explicit LooperExecutor(
+	    std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero())
+	    : timers_(slack) {
 		is_active_.store(true, std::memory_order_relaxed);
 		work_thread_ = std::thread(&LooperExecutor::run_loop, this);
 	}
@@ -67,16 +109,60 @@ public:
 
 public:
 	// 执行调度，即将任务函数 push 至循环队列中等待执行
+	// 仅在执行线程挂起时唤醒
 	void execute(std::function<void()>&& func) override {
 		std::unique_lock<std::mutex> lk(queue_mutex_);
 
 		if (is_active_.load(std::memory_order_relaxed)) {
-			executable_queue_.push(func);
+			executable_queue_.push_back(std::move(func));
+			has_executable_.store(true, std::memory_order_relaxed);
 			lk.unlock();
-			queue_condition_.notify_one();
+			notify_if_sleeping();
+		}
+	}
+
+	// 协程恢复调度，将协程句柄 push 至无锁环形队列，不进行内存分配
+	// 环形队列已满时退化为 execute 调用
+	void schedule(std::coroutine_handle<> handle) override {
+
+		if (!is_active_.load(std::memory_order_relaxed))
+			return;
+
+		if (!handle_queue_.try_push(handle)) {
+			execute([handle]() { handle.resume(); });
+			return;
 		}
+
+		// 与 run_loop 挂起前的 fence 配对，保证执行线程要么看到该句柄，要么已经标记挂起
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		notify_if_sleeping();
+	}
+
+	// 协程延时恢复调度，定时事件由执行线程自行管理，到期后直接在执行线程上恢复
+	// 不经过全局定时调度器，避免跨线程加锁及额外的线程切换
+	TimerHandle schedule_after(std::coroutine_handle<> handle,
+	                           std::chrono::nanoseconds delay) override {
+		return execute_after([handle]() { handle.resume(); }, delay);
 	}
 
+	TimerHandle execute_after(std::function<void()>&& func,
+	                          std::chrono::nanoseconds delay) override {
+		if (!is_active_.load(std::memory_order_relaxed))
+			return {};
+
+		// 仅当新事件早于当前最近的到期时间时，才需要唤醒执行线程重新计算等待时间
+		bool earliest = false;
+		auto timer = timers_.add(std::move(func), delay, earliest);
+		if (earliest) {
+			notify_if_sleeping();
+		}
+
+		return timer;
+	}
+
+	// 修改定时合并窗口，仅影响此后添加的定时事件
+	void set_slack(std::chrono::nanoseconds slack) { timers_.set_slack(slack); }
+
 	// 循环关闭及资源清理
 	void shutdown(bool wait_for_complete = true) {
 
@@ -85,14 +171,22 @@ public:
 			return;
 
 		is_active_.store(false, std::memory_order_relaxed);
+		timers_.close(!wait_for_complete);
 		if (!wait_for_complete) {
 
-			// 直接清空任务队列
+			// 直接清空任务队列，定时事件已由 close 丢弃
 			std::unique_lock<std::mutex> lk(queue_mutex_);
-			decltype(executable_queue_) empty_queue;
-			std::swap(executable_queue_, empty_queue);
+			executable_queue_.clear();
+			has_executable_.store(false, std::memory_order_relaxed);
+
+			while (handle_queue_.try_pop()) {
+			}
 		}
 
+		// 获取一次锁，避免执行线程检查循环状态后、进入等待前错过唤醒
+		std::unique_lock<std::mutex> lk(queue_mutex_);
+		lk.unlock();
+
 		// 这里其实只需要 notify_one() 即可，因为 wait
 		// 在条件变量上的只可能是内部线程
 		// 出于最后循环关闭及资源释放语义考虑，采用 notify_all()
@@ -107,31 +201,103 @@ public:
     }
 
 private:
+	// 挂起前自旋检查任务的次数
+	static constexpr int kSpinCount = 128;
+
+	bool has_work() const {
+		return has_executable_.load(std::memory_order_relaxed) ||
+		       !handle_queue_.empty();
+	}
+
+	// 执行线程挂起时才获取锁并唤醒
+	void notify_if_sleeping() {
+		if (sleeping_.load(std::memory_order_seq_cst)) {
+			std::unique_lock<std::mutex> lk(queue_mutex_);
+			lk.unlock();
+			queue_condition_.notify_one();
+		}
+	}
+
+	// 执行当前所有待执行任务，返回是否执行了任务
+	bool run_batch(std::vector<std::function<void()>>& batch) {
+		bool executed = false;
+
+		// 协程句柄无需加锁即可取出，单批次最多取出队列容量个，避免任务函数饥饿
+		for (std::size_t i = 0; i < kHandleQueueCapacity; ++i) {
+			auto handle = handle_queue_.try_pop();
+			if (!handle)
+				break;
+
+			handle->resume();
+			executed = true;
+		}
+
+		// 一次加锁交换出全部任务函数，交换后的 vector 保留容量供下次复用
+		if (has_executable_.load(std::memory_order_relaxed)) {
+			std::unique_lock<std::mutex> lk(queue_mutex_);
+			std::swap(batch, executable_queue_);
+			has_executable_.store(false, std::memory_order_relaxed);
+		}
+
+		for (auto& func : batch) {
+			func();
+			executed = true;
+		}
+		batch.clear();
+
+		return executed;
+	}
+
 	// 循环执行逻辑
 	void run_loop() {
 
+		std::vector<std::function<void()>> batch;
+		IntrusiveList<DelayedExecutable> expired;
+
 		// 当循环激活或者还存在未被消费掉的事件（使用或保证在执行完所有任务都能够得到执行）
 		// 在调度位置设置了当循环未激活时无法再次添加任务
-		while (is_active_.load(std::memory_order_relaxed) ||
-		       !executable_queue_.empty()) {
-			std::unique_lock lk{queue_mutex_};
+		while (true) {
 
-			// 任务队列为空执行挂起，等待任务添加时唤醒
-			if (executable_queue_.empty()) {
-				queue_condition_.wait(lk);
+			bool executed = timers_.run(expired);
+			if (run_batch(batch) || executed)
+				continue;
 
-				if (executable_queue_.empty())
-					continue;
+			// 短暂自旋等待新任务，避免频繁挂起唤醒
+			bool found = false;
+			for (int i = 0; i < kSpinCount && !found; ++i) {
+				CPU_RELAX();
+				found = has_work();
 			}
 
-			// 取出任务
-			auto func = executable_queue_.front();
-			executable_queue_.pop();
+			if (found)
+				continue;
 
-			lk.unlock();
+			// 标记挂起后再次检查任务及最近的到期时间，与投递方的检查顺序相反，避免丢失唤醒
+			std::unique_lock<std::mutex> lk(queue_mutex_);
+			sleeping_.store(true, std::memory_order_seq_cst);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (!has_work()) {
+				int64_t next_time = timers_.deadline();
+
+				// 关闭后仍需等待剩余定时事件到期
+				if (next_time == ExecutorTimers::kNoDeadline) {
+					if (!is_active_.load(std::memory_order_relaxed)) {
+						sleeping_.store(false, std::memory_order_relaxed);
+						break;
+					}
+
+					queue_condition_.wait(lk);
+				} else {
+
+					// 按最近的到期时间阻塞，有更早的定时事件或新任务时被唤醒
+					queue_condition_.wait_until(
+					    lk, std::chrono::steady_clock::time_point(
+					            std::chrono::nanoseconds(next_time)));
+				}
+			}
 
-			// 任务执行
-			func();
+			sleeping_.store(false, std::memory_order_relaxed);
 		}
 
 		DEBUGFMTLOG("running loop exit!");
@@ -141,28 +307,611 @@ private:
 private:
 	std::condition_variable queue_condition_{};
 	std::mutex queue_mutex_{};
-	std::queue<std::function<void()>> executable_queue_{};
+	std::vector<std::function<void()>> executable_queue_{};
+	std::atomic<bool> has_executable_{};
+
+	// 协程句柄队列，DispatchAwaiter、channel 等恢复协程时使用
+	static constexpr std::size_t kHandleQueueCapacity = 4096;
+	MpmcRingBuffer<std::coroutine_handle<>> handle_queue_{kHandleQueueCapacity};
+
+	// 执行线程是否处于挂起状态，投递方据此判断是否需要唤醒
+	std::atomic<bool> sleeping_{};
+
+	// 定时事件，到期后在执行线程上执行
+	ExecutorTimers timers_;
 
 	std::atomic<bool> is_active_{};
 	std::thread work_thread_{};
 };
 
+// 固定线程数的线程池调度器
+// 所有工作线程共享同一个任务队列，任务由任意空闲线程取出执行
+// 定时事件由线程池自行管理，同一时刻至多一个空闲线程按最近的到期时间阻塞等待，
+// 其余空闲线程仅等待新任务，到期事件在工作线程上执行
+// 关闭语义与 LooperExecutor 一致，可直接作为 Task 的 Executor 模板参数使用
+class ThreadPoolExecutor : public AbstractExecutor {
+
+public:
+	// 默认按 CPU 核数创建工作线程
+	// slack 为定时合并窗口，语义同 LooperExecutor
+	explicit ThreadPoolExecutor(
+	    std::size_t worker_count = std::thread::hardware_concurrency(),
+	    std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero())
+	    : timers_(slack) {
+		worker_count = std::max<std::size_t>(worker_count, 1);
+
+		is_active_.store(true, std::memory_order_relaxed);
+
+		work_threads_.reserve(worker_count);
+		for (std::size_t i = 0; i < worker_count; ++i) {
+			work_threads_.emplace_back(&ThreadPoolExecutor::run_loop, this);
+		}
+	}
+
+	~ThreadPoolExecutor() {
+		shutdown(false);
+		join();
+	}
+
+public:
+	// 执行调度，将任务函数 push 至共享队列，唤醒一个空闲线程
+	// 仅等待新任务的空闲线程不足时，唤醒等待定时事件的线程
+	void execute(std::function<void()>&& func) override {
+		std::unique_lock<std::mutex> lk(queue_mutex_);
+
+		if (is_active_.load(std::memory_order_relaxed)) {
+			executable_queue_.push_back(std::move(func));
+			bool wake_timer =
+			    timer_waiting_ && executable_queue_.size() > idle_count_;
+			lk.unlock();
+			queue_condition_.notify_one();
+
+			if (wake_timer) {
+				timer_condition_.notify_one();
+			}
+		}
+	}
+
+	// 协程延时恢复调度，定时事件由线程池自行管理，到期后直接在工作线程上恢复
+	// 不经过全局定时调度器，避免额外的定时线程及线程切换
+	TimerHandle schedule_after(std::coroutine_handle<> handle,
+	                           std::chrono::nanoseconds delay) override {
+		return execute_after([handle]() { handle.resume(); }, delay);
+	}
+
+	TimerHandle execute_after(std::function<void()>&& func,
+	                          std::chrono::nanoseconds delay) override {
+		if (!is_active_.load(std::memory_order_relaxed))
+			return {};
+
+		bool earliest = false;
+		auto timer = timers_.add(std::move(func), delay, earliest);
+
+		// 仅当新事件早于当前最近的到期时间时，才需要唤醒线程重新计算等待时间
+		// 空闲线程在 queue_mutex_ 内读取到期时间，加锁后唤醒避免丢失
+		// 没有线程等待定时事件时，唤醒一个空闲线程承担等待
+		if (earliest) {
+			std::unique_lock<std::mutex> lk(queue_mutex_);
+			bool wake_timer = timer_waiting_;
+			lk.unlock();
+
+			if (wake_timer) {
+				timer_condition_.notify_one();
+			} else {
+				queue_condition_.notify_one();
+			}
+		}
+
+		return timer;
+	}
+
+	// 修改定时合并窗口，仅影响此后添加的定时事件
+	void set_slack(std::chrono::nanoseconds slack) { timers_.set_slack(slack); }
+
+	// 线程池关闭，wait_for_complete 为 false 时丢弃尚未执行的任务及定时事件
+	void shutdown(bool wait_for_complete = true) {
+
+		if (!is_active_.load(std::memory_order_relaxed))
+			return;
+
+		std::unique_lock<std::mutex> lk(queue_mutex_);
+		is_active_.store(false, std::memory_order_relaxed);
+		timers_.close(!wait_for_complete);
+
+		if (!wait_for_complete) {
+			executable_queue_.clear();
+		}
+
+		lk.unlock();
+		queue_condition_.notify_all();
+		timer_condition_.notify_all();
+	}
+
+	void join() {
+		for (auto& work_thread : work_threads_) {
+			if (work_thread.joinable()) {
+				work_thread.join();
+			}
+		}
+	}
+
+	std::size_t worker_count() const { return work_threads_.size(); }
+
+private:
+	// 工作线程循环执行逻辑，关闭且任务队列为空、定时事件均已执行时退出
+	void run_loop() {
+		IntrusiveList<DelayedExecutable> expired;
+		std::unique_lock<std::mutex> lk(queue_mutex_);
+
+		while (true) {
+			// 定时事件执行期间不持有 queue_mutex_
+			if (timers_.due()) {
+				lk.unlock();
+				bool executed = timers_.run(expired);
+				lk.lock();
+
+				if (executed)
+					continue;
+			}
+
+			if (!executable_queue_.empty()) {
+				auto func = std::move(executable_queue_.front());
+				executable_queue_.pop_front();
+				lk.unlock();
+
+				func();
+
+				lk.lock();
+				continue;
+			}
+
+			// 关闭后仍需等待剩余定时事件到期
+			if (!is_active_.load(std::memory_order_relaxed) && timers_.empty())
+				break;
+
+			wait_for_work(lk);
+		}
+		lk.unlock();
+
+		// 其余线程可能仍在等待，唤醒后由其自行检查退出条件
+		queue_condition_.notify_all();
+
+		DEBUGFMTLOG("thread pool worker exit!");
+	}
+
+	// 持有锁时调用，挂起等待新任务或定时事件到期
+	// 没有线程等待定时事件时由当前线程按最近的到期时间阻塞，否则仅等待新任务
+	void wait_for_work(std::unique_lock<std::mutex>& lk) {
+		int64_t deadline = timers_.deadline();
+		if (!timer_waiting_ && deadline != ExecutorTimers::kNoDeadline) {
+			timer_waiting_ = true;
+			timer_condition_.wait_until(
+			    lk, std::chrono::steady_clock::time_point(
+			            std::chrono::nanoseconds(deadline)));
+			timer_waiting_ = false;
+			return;
+		}
+
+		++idle_count_;
+		queue_condition_.wait(lk);
+		--idle_count_;
+	}
+
+private:
+	std::condition_variable queue_condition_{};
+	std::mutex queue_mutex_{};
+	std::deque<std::function<void()>> executable_queue_{};
+
+	// 仅等待新任务的空闲线程数，由 queue_mutex_ 保护
+	std::size_t idle_count_{};
+
+	// 定时事件，到期后在工作线程上执行
+	// timer_waiting_ 表示已有线程在 timer_condition_ 上按最近的到期时间等待，
+	// 由 queue_mutex_ 保护
+	ExecutorTimers timers_;
+	bool timer_waiting_{};
+	std::condition_variable timer_condition_{};
+
+	std::atomic<bool> is_active_{};
+	std::vector<std::thread> work_threads_{};
+};
+
+// 调度器实例注册表，按调度器类型共享同一个长期存活的实例
+// Task 通过该注册表获取调度器，避免每个协程构造独立的调度器对象
+// （如 LooperExecutor 每次构造都会创建并回收一个线程）
+// 可以通过 set() 替换为外部构造的实例（如自定义线程数的调度器），需保证其生命周期
+template <typename Executor> class SharedExecutor {
+public:
+	static AbstractExecutor* get() {
+		auto executor = executor_.load(std::memory_order_acquire);
+		if (executor)
+			return executor;
+
+		static Executor default_executor;
+		return &default_executor;
+	}
+
+	static void set(AbstractExecutor* executor) {
+		executor_.store(executor, std::memory_order_release);
+	}
+
+private:
+	static inline std::atomic<AbstractExecutor*> executor_{};
+};
+
 // 功能实现与 LooperExecutor 一致，但全局单例
 // 所有采用 SharedLoopExector 协程共享同一个调度器，即调度到同一个线程上
 class SharedLooperExecutor : public AbstractExecutor {
 public:
 	void execute(std::function<void()>&& func) override {
+		looper().execute(std::move(func));
+	}
+
+	void schedule(std::coroutine_handle<> handle) override {
+		looper().schedule(handle);
+	}
+
+	TimerHandle schedule_after(std::coroutine_handle<> handle,
+	                           std::chrono::nanoseconds delay) override {
+		return looper().schedule_after(handle, delay);
+	}
+
+	TimerHandle execute_after(std::function<void()>&& func,
+	                          std::chrono::nanoseconds delay) override {
+		return looper().execute_after(std::move(func), delay);
+	}
+
+private:
+	static LooperExecutor& looper() {
 		static LooperExecutor share_looper_execuetor;
-		share_looper_execuetor.execute(std::move(func));
+		return share_looper_execuetor;
 	}
 };
 
-// 参考 Golang 实现协程调度器
-// 任务窃取调度器
+// 参考 Golang 实现协程调度器（M:P:G 模型）
+// 每个工作线程 (M) 绑定一个处理器 (P)，P 持有本地运行队列，任务 (G) 即 func
+// 工作线程内投递的任务进入本地队列，外部线程投递的任务进入全局队列
+// 空闲 P 依次检查本地队列、全局队列，最后从其他 P 窃取一半任务，均无任务时挂起
+// 定时事件由调度器自行管理，同一时刻至多一个空闲线程按最近的到期时间等待，
+// 到期事件在工作线程上执行
 class GolangExecutor : public AbstractExecutor {
 
 public:
-	void execute(std::function<void()>&& func) override {}
+	// 默认按 CPU 核数创建工作线程
+	// slack 为定时合并窗口，语义同 LooperExecutor
+	explicit GolangExecutor(
+	    std::size_t worker_count = std::thread::hardware_concurrency(),
+	    std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero())
+	    : timers_(slack) {
+		worker_count = std::max<std::size_t>(worker_count, 1);
+
+		is_active_.store(true, std::memory_order_relaxed);
+
+		processors_.reserve(worker_count);
+		for (std::size_t i = 0; i < worker_count; ++i) {
+			processors_.emplace_back(std::make_unique<Processor>());
+		}
+
+		work_threads_.reserve(worker_count);
+		for (std::size_t i = 0; i < worker_count; ++i) {
+			work_threads_.emplace_back(&GolangExecutor::run_loop, this, i);
+		}
+	}
+
+	~GolangExecutor() {
+		shutdown(false);
+		join();
+	}
+
+public:
+	// 执行调度，工作线程内投递至本地队列，否则投递至全局队列
+	void execute(std::function<void()>&& func) override {
+
+		if (!is_active_.load(std::memory_order_relaxed))
+			return;
+
+		// 先增加待执行任务数再入队，避免任务被取出时计数下溢
+		pending_count_.fetch_add(1, std::memory_order_seq_cst);
+
+		if (current_executor_ == this) {
+			auto& processor = *processors_[current_index_];
+			std::unique_lock<std::mutex> lk(processor.queue_mutex_);
+			processor.run_queue_.push_back(std::move(func));
+		} else {
+			std::unique_lock<std::mutex> lk(global_mutex_);
+			global_queue_.push_back(std::move(func));
+		}
+
+		// 先增加待执行任务数再检查空闲线程数，与 run_loop 中顺序相反
+		// 保证二者至少有一方能看到对方的修改，避免丢失唤醒
+		// 没有仅等待新任务的空闲线程时，唤醒等待定时事件的线程
+		if (idle_count_.load(std::memory_order_seq_cst) > 0) {
+			std::unique_lock<std::mutex> lk(idle_mutex_);
+			lk.unlock();
+			idle_condition_.notify_one();
+		} else if (timer_waiting_.load(std::memory_order_seq_cst)) {
+			std::unique_lock<std::mutex> lk(idle_mutex_);
+			lk.unlock();
+			timer_condition_.notify_one();
+		}
+	}
+
+	// 协程延时恢复调度，定时事件由调度器自行管理，到期后直接在工作线程上恢复
+	TimerHandle schedule_after(std::coroutine_handle<> handle,
+	                           std::chrono::nanoseconds delay) override {
+		return execute_after([handle]() { handle.resume(); }, delay);
+	}
+
+	TimerHandle execute_after(std::function<void()>&& func,
+	                          std::chrono::nanoseconds delay) override {
+		if (!is_active_.load(std::memory_order_relaxed))
+			return {};
+
+		// 仅当新事件早于当前最近的到期时间时，才需要唤醒线程重新计算等待时间
+		bool earliest = false;
+		auto timer = timers_.add(std::move(func), delay, earliest);
+
+		// 空闲线程在 idle_mutex_ 内检查到期时间，加锁后唤醒避免丢失
+		// 没有线程等待定时事件时，唤醒一个空闲线程承担等待
+		if (earliest) {
+			std::unique_lock<std::mutex> idle_lk(idle_mutex_);
+			bool timer_waiting = timer_waiting_.load(std::memory_order_relaxed);
+			idle_lk.unlock();
+
+			if (timer_waiting) {
+				timer_condition_.notify_one();
+			} else {
+				idle_condition_.notify_one();
+			}
+		}
+
+		return timer;
+	}
+
+	// 修改定时合并窗口，仅影响此后添加的定时事件
+	void set_slack(std::chrono::nanoseconds slack) { timers_.set_slack(slack); }
+
+	// 调度器关闭及资源清理，语义与 LooperExecutor 一致
+	void shutdown(bool wait_for_complete = true) {
+
+		if (!is_active_.load(std::memory_order_relaxed))
+			return;
+
+		is_active_.store(false, std::memory_order_relaxed);
+
+		if (!wait_for_complete) {
+
+			// 直接清空全局队列及所有本地队列
+			std::size_t dropped = 0;
+			{
+				std::unique_lock<std::mutex> lk(global_mutex_);
+				dropped += std::exchange(global_queue_, {}).size();
+			}
+
+			for (auto& processor : processors_) {
+				std::unique_lock<std::mutex> lk(processor->queue_mutex_);
+				dropped += std::exchange(processor->run_queue_, {}).size();
+			}
+
+			pending_count_.fetch_sub(dropped, std::memory_order_seq_cst);
+		}
+
+		// 不再接受新的定时事件，不等待时丢弃尚未到期的定时事件
+		timers_.close(!wait_for_complete);
+
+		std::unique_lock<std::mutex> lk(idle_mutex_);
+		lk.unlock();
+		idle_condition_.notify_all();
+		timer_condition_.notify_all();
+	}
+
+	void join() {
+		for (auto& work_thread : work_threads_) {
+			if (work_thread.joinable()) {
+				work_thread.join();
+			}
+		}
+	}
+
+	std::size_t worker_count() const { return processors_.size(); }
+
+private:
+	// 处理器 P，持有本地运行队列
+	// 本地线程从队首取任务，窃取者从队尾取走一半任务
+	struct Processor {
+		std::mutex queue_mutex_{};
+		std::deque<std::function<void()>> run_queue_{};
+	};
+
+	// 每 kGlobalQueueInterval 次调度优先检查一次全局队列，避免全局队列任务饥饿
+	static constexpr std::size_t kGlobalQueueInterval = 61;
+
+	// 工作线程循环执行逻辑
+	void run_loop(std::size_t index) {
+
+		current_executor_ = this;
+		current_index_ = index;
+
+		IntrusiveList<DelayedExecutable> expired;
+		std::size_t tick = 0;
+		while (true) {
+			if (timers_.run(expired))
+				continue;
+
+			std::function<void()> func;
+
+			if (take_task(index, ++tick, func)) {
+				func();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lk(idle_mutex_);
+			int64_t deadline = timers_.deadline();
+
+			// 没有线程等待定时事件时，由当前线程按最近的到期时间等待
+			// 有新任务或更早的定时事件时被唤醒
+			if (deadline != ExecutorTimers::kNoDeadline &&
+			    !timer_waiting_.load(std::memory_order_relaxed)) {
+				timer_waiting_.store(true, std::memory_order_seq_cst);
+				timer_condition_.wait_until(
+				    lk,
+				    std::chrono::steady_clock::time_point(
+				        std::chrono::nanoseconds(deadline)),
+				    [this, deadline]() {
+					    return pending_count_.load(std::memory_order_seq_cst) >
+					               0 ||
+					           timers_.deadline() != deadline;
+				    });
+				timer_waiting_.store(false, std::memory_order_seq_cst);
+				continue;
+			}
+
+			// 无任务可执行，挂起等待新任务投递，关闭后仍需等待剩余定时事件到期
+			idle_count_.fetch_add(1, std::memory_order_seq_cst);
+			idle_condition_.wait(lk, [this]() {
+				return pending_count_.load(std::memory_order_seq_cst) > 0 ||
+				       (!is_active_.load(std::memory_order_relaxed) &&
+				        !has_timers()) ||
+				       (has_timers() &&
+				        !timer_waiting_.load(std::memory_order_relaxed));
+			});
+			idle_count_.fetch_sub(1, std::memory_order_seq_cst);
+
+			if (!is_active_.load(std::memory_order_relaxed) &&
+			    pending_count_.load(std::memory_order_seq_cst) == 0 &&
+			    !has_timers())
+				break;
+		}
+
+		current_executor_ = nullptr;
+
+		// 其余线程可能仍在等待，唤醒后由其自行检查退出条件
+		std::unique_lock<std::mutex> lk(idle_mutex_);
+		lk.unlock();
+		idle_condition_.notify_all();
+
+		DEBUGFMTLOG("golang executor worker {} exit!", index);
+	}
+
+	bool has_timers() const { return !timers_.empty(); }
+
+	// 依次从本地队列、全局队列、其他处理器获取任务
+	bool take_task(std::size_t index, std::size_t tick,
+	               std::function<void()>& func) {
+
+		bool found = (tick % kGlobalQueueInterval == 0 &&
+		              take_global(index, func)) ||
+		             take_local(index, func) || take_global(index, func) ||
+		             steal(index, func);
+
+		if (found) {
+			pending_count_.fetch_sub(1, std::memory_order_seq_cst);
+		}
+
+		return found;
+	}
+
+	bool take_local(std::size_t index, std::function<void()>& func) {
+		auto& processor = *processors_[index];
+		std::unique_lock<std::mutex> lk(processor.queue_mutex_);
+
+		if (processor.run_queue_.empty())
+			return false;
+
+		func = std::move(processor.run_queue_.front());
+		processor.run_queue_.pop_front();
+		return true;
+	}
+
+	// 从全局队列批量获取任务，按处理器数量均分，多余部分放入本地队列
+	bool take_global(std::size_t index, std::function<void()>& func) {
+		std::deque<std::function<void()>> batch;
+
+		{
+			std::unique_lock<std::mutex> lk(global_mutex_);
+			if (global_queue_.empty())
+				return false;
+
+			std::size_t count = std::min(
+			    global_queue_.size(),
+			    global_queue_.size() / processors_.size() + 1);
+
+			auto last = global_queue_.begin() + count;
+			std::move(global_queue_.begin(), last, std::back_inserter(batch));
+			global_queue_.erase(global_queue_.begin(), last);
+		}
+
+		func = std::move(batch.front());
+		batch.pop_front();
+		push_local(index, batch);
+		return true;
+	}
+
+	// 从其他处理器队尾窃取一半任务
+	bool steal(std::size_t index, std::function<void()>& func) {
+		std::size_t count = processors_.size();
+
+		for (std::size_t i = 1; i < count; ++i) {
+			auto& victim = *processors_[(index + i) % count];
+			std::deque<std::function<void()>> batch;
+
+			{
+				std::unique_lock<std::mutex> lk(victim.queue_mutex_);
+				if (victim.run_queue_.empty())
+					continue;
+
+				std::size_t half = (victim.run_queue_.size() + 1) / 2;
+				auto first = victim.run_queue_.end() - half;
+				std::move(first, victim.run_queue_.end(),
+				          std::back_inserter(batch));
+				victim.run_queue_.erase(first, victim.run_queue_.end());
+			}
+
+			func = std::move(batch.front());
+			batch.pop_front();
+			push_local(index, batch);
+			return true;
+		}
+
+		return false;
+	}
+
+	void push_local(std::size_t index,
+	                std::deque<std::function<void()>>& batch) {
+		if (batch.empty())
+			return;
+
+		auto& processor = *processors_[index];
+		std::unique_lock<std::mutex> lk(processor.queue_mutex_);
+		std::move(batch.begin(), batch.end(),
+		          std::back_inserter(processor.run_queue_));
+	}
+
+private:
+	std::vector<std::unique_ptr<Processor>> processors_{};
+	std::vector<std::thread> work_threads_{};
+
+	std::mutex global_mutex_{};
+	std::deque<std::function<void()>> global_queue_{};
+
+	// 尚未被取出执行的任务总数及空闲线程数，用于判断是否需要唤醒/挂起
+	std::atomic<std::size_t> pending_count_{};
+	std::atomic<std::size_t> idle_count_{};
+	std::condition_variable idle_condition_{};
+	std::mutex idle_mutex_{};
+
+	// 定时事件，到期后在工作线程上执行
+	// timer_waiting_ 表示已有线程在 timer_condition_ 上按最近的到期时间等待，
+	// 在 idle_mutex_ 内修改
+	ExecutorTimers timers_;
+	std::atomic<bool> timer_waiting_{};
+	std::condition_variable timer_condition_{};
+
+	std::atomic<bool> is_active_{};
+
+	// 当前线程所属调度器及处理器编号，用于判断是否投递至本地队列
+	static inline thread_local GolangExecutor* current_executor_{};
+	static inline thread_local std::size_t current_index_{};
 };
 
 GOCOROUTINE_NAMESPACE_END
@@ -0,0 +1,144 @@
+#ifndef GOCOROUTINE_EXECUTOR_TIMERS_H
+#define GOCOROUTINE_EXECUTOR_TIMERS_H
+
+#include "gocoroutine/intrusive_list.h"
+#include "gocoroutine/scheduler.h"
+#include "gocoroutine/timing_wheel.h"
+#include "gocoroutine/utils.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+
+GOCOROUTINE_NAMESPACE_BEGIN
+
+// 调度器自行管理的定时事件，LooperExecutor、ThreadPoolExecutor 及 GolangExecutor 共用
+// 持有时间轮及保护它的互斥锁，并以原子变量记录最近的到期时间，执行线程据此判断
+// 是否需要加锁处理定时事件，或按该时间阻塞等待
+// 唤醒等待线程由调度器负责：add 报告新事件早于此前最近的到期时间时，
+// 调度器在自身的等待锁内唤醒，等待方须在同一把锁内读取 deadline()
+class ExecutorTimers {
+
+public:
+	static constexpr int64_t kNoDeadline = std::numeric_limits<int64_t>::max();
+
+	// slack 为定时合并窗口，语义同 Scheduler
+	explicit ExecutorTimers(
+	    std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero())
+	    : slack_(slack.count()) {}
+
+	ExecutorTimers(const ExecutorTimers&) = delete;
+	ExecutorTimers& operator=(const ExecutorTimers&) = delete;
+
+public:
+	// 添加定时事件，关闭后返回空句柄
+	// 新事件早于此前最近的到期时间时 earliest 置为 true，调用方据此唤醒等待线程
+	// 最近的到期时间按合并对齐后的时间记录，落在同一窗口内的事件只唤醒一次
+	TimerHandle add(std::function<void()>&& func, std::chrono::nanoseconds delay,
+	                bool& earliest) {
+		earliest = false;
+		int64_t delay_time = delay.count() < 0 ? 0 : delay.count();
+		std::lock_guard<std::mutex> lk(mutex_);
+
+		if (closed_)
+			return {};
+
+		int64_t expire_time = Scheduler::current_time() + delay_time;
+		int64_t slack = slack_.load(std::memory_order_relaxed);
+		auto node = timing_wheel_.add(std::move(func), expire_time,
+		                              slack < 0 ? 0 : slack);
+
+		int64_t fire_time = node->get_fire_time();
+		if (fire_time < deadline_.load(std::memory_order_relaxed)) {
+			deadline_.store(fire_time, std::memory_order_seq_cst);
+			earliest = true;
+		}
+
+		return TimerHandle(&mutex_, &timing_wheel_, node, node->get_id());
+	}
+
+	// 执行所有到期的定时事件，返回是否执行了定时事件
+	// 仅在最近的到期时间已过时才加锁，事件执行期间不持有锁
+	bool run(IntrusiveList<DelayedExecutable>& expired) {
+		int64_t deadline = this->deadline();
+		if (deadline == kNoDeadline)
+			return false;
+
+		int64_t now = Scheduler::current_time();
+		if (now < deadline)
+			return false;
+
+		std::unique_lock<std::mutex> lk(mutex_);
+		timing_wheel_.advance(now, expired);
+		update_deadline();
+		lk.unlock();
+
+		if (expired.empty())
+			return false;
+
+		IntrusiveList<DelayedExecutable> finished;
+		while (auto executable = expired.pop_front()) {
+			(*executable)();
+			finished.push_back(executable);
+		}
+
+		lk.lock();
+		timing_wheel_.release(finished);
+		return true;
+	}
+
+	// 最近的到期时间已过，下一次 run 将执行定时事件
+	bool due() const {
+		int64_t deadline = this->deadline();
+		return deadline != kNoDeadline && Scheduler::current_time() >= deadline;
+	}
+
+	// 调度器关闭时调用，此后不再接受新的定时事件
+	// discard 为 true 时丢弃尚未到期的定时事件，否则仍等待其到期执行
+	void close(bool discard) {
+		std::lock_guard<std::mutex> lk(mutex_);
+		closed_ = true;
+
+		if (discard) {
+			IntrusiveList<DelayedExecutable> expired;
+			timing_wheel_.advance(kNoDeadline - 1, expired);
+			timing_wheel_.release(expired);
+			deadline_.store(kNoDeadline, std::memory_order_seq_cst);
+		}
+	}
+
+	// 最近的到期时间，没有定时事件时为 kNoDeadline
+	// 已取消的事件在下一次 run 之前仍可能使其偏早，只会造成一次多余的唤醒
+	int64_t deadline() const { return deadline_.load(std::memory_order_seq_cst); }
+
+	bool empty() const { return deadline() == kNoDeadline; }
+
+	// 修改定时合并窗口，仅影响此后添加的定时事件
+	void set_slack(std::chrono::nanoseconds slack) {
+		slack_.store(slack.count(), std::memory_order_relaxed);
+	}
+
+private:
+	// 持有锁时调用，按时间轮重新计算最近的到期时间
+	void update_deadline() {
+		int64_t next_time = timing_wheel_.next_time();
+		deadline_.store(next_time < 0 ? kNoDeadline : next_time,
+		                std::memory_order_seq_cst);
+	}
+
+private:
+	std::mutex mutex_{};
+	TimingWheel timing_wheel_{Scheduler::current_time(),
+	                          Scheduler::kTickDuration};
+	std::atomic<int64_t> deadline_{kNoDeadline};
+	bool closed_{};
+
+	// 定时合并窗口，单位纳秒
+	std::atomic<int64_t> slack_{};
+};
+
+GOCOROUTINE_NAMESPACE_END
+
+#endif
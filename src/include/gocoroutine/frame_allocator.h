@@ -0,0 +1,278 @@
+#ifndef GOCOROUTINE_FRAME_ALLOCATOR_H
+#define GOCOROUTINE_FRAME_ALLOCATOR_H
+
+#include "gocoroutine/intrusive_list.h"
+#include "gocoroutine/utils.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+
+GOCOROUTINE_NAMESPACE_BEGIN
+
+// 协程帧内存池统计信息
+// hits 为从空闲链表中直接复用的次数，misses 为空闲链表为空或超出大小等级时向系统申请的次数
+struct FramePoolStats {
+	uint64_t hits{};
+	uint64_t misses{};
+};
+
+// 协程帧内存池
+// 按 kSizeClassGranularity 字节划分大小等级，每个线程维护各等级的空闲链表
+// 内存块可以在任意线程释放，释放时归还至释放线程的空闲链表
+// 每个等级空闲链表长度超过 kMaxFreeBlocks 或帧大小超过最大等级时直接归还系统
+// 统计计数同样按线程记录，分配路径上不写共享的缓存行，stats() 时加锁汇总
+class FramePool {
+
+public:
+	static constexpr std::size_t kSizeClassGranularity = 64;
+	static constexpr std::size_t kSizeClassCount = 32;
+	static constexpr std::size_t kMaxFreeBlocks = 1024;
+
+public:
+	static void* allocate(std::size_t size) {
+		auto size_class = to_size_class(size);
+
+		auto& cache = thread_cache();
+		if (size_class < kSizeClassCount) {
+			if (!cache.released_ && cache.free_lists_[size_class]) {
+				auto block = cache.free_lists_[size_class];
+				cache.free_lists_[size_class] = block->next_;
+				--cache.free_counts_[size_class];
+
+				cache.count(cache.hits_);
+				return block;
+			}
+
+			size = to_block_size(size_class);
+		}
+
+		cache.count(cache.misses_);
+		return ::operator new(size);
+	}
+
+	static void deallocate(void* ptr, std::size_t size) {
+		auto size_class = to_size_class(size);
+
+		if (size_class < kSizeClassCount) {
+			auto& cache = thread_cache();
+			if (!cache.released_ &&
+			    cache.free_counts_[size_class] < kMaxFreeBlocks) {
+				auto block = static_cast<FreeBlock*>(ptr);
+				block->next_ = cache.free_lists_[size_class];
+				cache.free_lists_[size_class] = block;
+				++cache.free_counts_[size_class];
+				return;
+			}
+		}
+
+		::operator delete(ptr);
+	}
+
+	// 汇总所有线程（含已退出线程）的统计信息
+	static FramePoolStats stats() {
+		auto& registry = stats_registry();
+		std::lock_guard<std::mutex> lk(registry.mutex_);
+
+		auto stats = registry.retired_;
+		for (auto cache = registry.caches_.front(); cache; cache = cache->next_) {
+			stats.hits += cache->hits_.load(std::memory_order_relaxed);
+			stats.misses += cache->misses_.load(std::memory_order_relaxed);
+		}
+		return stats;
+	}
+
+private:
+	struct FreeBlock {
+		FreeBlock* next_{};
+	};
+
+	struct ThreadCache;
+
+	// 各线程统计计数的登记表，线程退出时将其计数并入 retired_
+	struct StatsRegistry {
+		std::mutex mutex_;
+		IntrusiveList<ThreadCache> caches_;
+		FramePoolStats retired_;
+	};
+
+	// 线程本地空闲链表，线程退出时归还所有内存块
+	struct ThreadCache {
+		ThreadCache() {
+			auto& registry = stats_registry();
+			std::lock_guard<std::mutex> lk(registry.mutex_);
+			registry.caches_.push_back(this);
+		}
+
+		~ThreadCache() {
+			released_ = true;
+			for (auto& block : free_lists_) {
+				while (block) {
+					::operator delete(std::exchange(block, block->next_));
+				}
+			}
+
+			auto& registry = stats_registry();
+			std::lock_guard<std::mutex> lk(registry.mutex_);
+			registry.caches_.remove(this);
+			registry.retired_.hits += hits_.load(std::memory_order_relaxed);
+			registry.retired_.misses += misses_.load(std::memory_order_relaxed);
+		}
+
+		// 只有所属线程写入，stats() 并发读取，无需原子的读-改-写
+		void count(std::atomic<uint64_t>& counter) {
+			counter.store(counter.load(std::memory_order_relaxed) + 1,
+			              std::memory_order_relaxed);
+		}
+
+		FreeBlock* free_lists_[kSizeClassCount]{};
+		std::size_t free_counts_[kSizeClassCount]{};
+		bool released_{false};
+
+		std::atomic<uint64_t> hits_{};
+		std::atomic<uint64_t> misses_{};
+
+		ThreadCache* prev_{};
+		ThreadCache* next_{};
+		IntrusiveList<ThreadCache>* list_{};
+	};
+
+	static StatsRegistry& stats_registry() {
+		static StatsRegistry registry;
+		return registry;
+	}
+
+	static ThreadCache& thread_cache() {
+		static thread_local ThreadCache cache;
+		return cache;
+	}
+
+	static std::size_t to_size_class(std::size_t size) {
+		return (size - 1) / kSizeClassGranularity;
+	}
+
+	static std::size_t to_block_size(std::size_t size_class) {
+		return (size_class + 1) * kSizeClassGranularity;
+	}
+};
+
+// 协程帧内存分配，由 TaskPromise 继承以提供 operator new/delete
+// 默认从 FramePool 中分配协程帧
+// 协程参数以 std::allocator_arg_t 及分配器开头时使用该分配器分配协程帧
+// 成员函数协程中 std::allocator_arg_t 位于对象参数之后
+// 分配器版本的 operator new 为模板，强制内联至协程入口，
+// 否则 GCC 会将其与非模板的 operator delete 误判为不匹配（-Wmismatched-new-delete）
+//
+// 帧尾部记录释放函数，分配器分配时其后再保存一份分配器副本，内存布局如下：
+// | coroutine frame (size) | deallocate function | [allocator] |
+class FrameAllocation {
+
+	using DeallocateFunc = void (*)(void* ptr, std::size_t size);
+
+public:
+	static void* operator new(std::size_t size) {
+		auto ptr = FramePool::allocate(pool_size(size));
+		store_deallocate(ptr, size, &deallocate_pool);
+		return ptr;
+	}
+
+	template <typename Allocator, typename... Args>
+	[[gnu::always_inline]] static void*
+	operator new(std::size_t size, std::allocator_arg_t,
+	             const Allocator& allocator, const Args&...) {
+		return allocate_with(size, allocator);
+	}
+
+	template <typename Object, typename Allocator, typename... Args>
+	[[gnu::always_inline]] static void*
+	operator new(std::size_t size, const Object&, std::allocator_arg_t,
+	             const Allocator& allocator, const Args&...) {
+		return allocate_with(size, allocator);
+	}
+
+	static void operator delete(void* ptr, std::size_t size) {
+		DeallocateFunc deallocate{};
+		std::memcpy(&deallocate, static_cast<std::byte*>(ptr) + tag_offset(size),
+		            sizeof(DeallocateFunc));
+		deallocate(ptr, size);
+	}
+
+private:
+	template <typename Allocator>
+	using ByteAllocator = typename std::allocator_traits<
+	    Allocator>::template rebind_alloc<std::byte>;
+
+	template <typename Allocator>
+	static void* allocate_with(std::size_t size, const Allocator& allocator) {
+		ByteAllocator<Allocator> byte_allocator(allocator);
+
+		auto ptr = static_cast<void*>(std::allocator_traits<
+		                              ByteAllocator<Allocator>>::
+		                                  allocate(byte_allocator,
+		                                           allocator_size<Allocator>(size)));
+
+		new (allocator_ptr<Allocator>(ptr, size))
+		    ByteAllocator<Allocator>(std::move(byte_allocator));
+		store_deallocate(ptr, size, &deallocate_allocator<Allocator>);
+		return ptr;
+	}
+
+	static void deallocate_pool(void* ptr, std::size_t size) {
+		FramePool::deallocate(ptr, pool_size(size));
+	}
+
+	template <typename Allocator>
+	static void deallocate_allocator(void* ptr, std::size_t size) {
+		auto stored = allocator_ptr<Allocator>(ptr, size);
+		ByteAllocator<Allocator> byte_allocator(std::move(*stored));
+		stored->~ByteAllocator<Allocator>();
+
+		std::allocator_traits<ByteAllocator<Allocator>>::deallocate(
+		    byte_allocator, static_cast<std::byte*>(ptr),
+		    allocator_size<Allocator>(size));
+	}
+
+	static void store_deallocate(void* ptr, std::size_t size,
+	                             DeallocateFunc deallocate) {
+		std::memcpy(static_cast<std::byte*>(ptr) + tag_offset(size),
+		            &deallocate, sizeof(DeallocateFunc));
+	}
+
+	static constexpr std::size_t align_up(std::size_t size,
+	                                      std::size_t alignment) {
+		return (size + alignment - 1) / alignment * alignment;
+	}
+
+	static constexpr std::size_t tag_offset(std::size_t size) {
+		return align_up(size, alignof(DeallocateFunc));
+	}
+
+	static constexpr std::size_t pool_size(std::size_t size) {
+		return tag_offset(size) + sizeof(DeallocateFunc);
+	}
+
+	template <typename Allocator>
+	static constexpr std::size_t allocator_offset(std::size_t size) {
+		return align_up(pool_size(size), alignof(ByteAllocator<Allocator>));
+	}
+
+	template <typename Allocator>
+	static constexpr std::size_t allocator_size(std::size_t size) {
+		return allocator_offset<Allocator>(size) +
+		       sizeof(ByteAllocator<Allocator>);
+	}
+
+	template <typename Allocator>
+	static ByteAllocator<Allocator>* allocator_ptr(void* ptr,
+	                                               std::size_t size) {
+		return reinterpret_cast<ByteAllocator<Allocator>*>(
+		    static_cast<std::byte*>(ptr) + allocator_offset<Allocator>(size));
+	}
+};
+
+GOCOROUTINE_NAMESPACE_END
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef GOCOROUTINE_INTRUSIVE_LIST_H
+#define GOCOROUTINE_INTRUSIVE_LIST_H
+
+#include "gocoroutine/utils.h"
+#include <cstddef>
+#include <utility>
+
+GOCOROUTINE_NAMESPACE_BEGIN
+
+// 侵入式双向链表
+// 节点类型需要包含 Node* prev_、Node* next_ 及 IntrusiveList<Node>* list_ 成员，
+// 链表本身不持有节点内存
+// 插入及删除均为 O(1) 且不进行内存分配，节点不在链表中时 prev_/next_/list_ 均为空
+// list_ 记录节点所在的链表，contains 据此精确判断，节点位于其他链表中时返回 false；
+// 移动及 splice_back 需逐个更新 list_，为 O(n)
+template <typename Node> class IntrusiveList {
+
+public:
+	IntrusiveList() = default;
+
+	IntrusiveList(IntrusiveList&& other) noexcept
+	    : head_(std::exchange(other.head_, {}))
+	    , tail_(std::exchange(other.tail_, {}))
+	    , size_(std::exchange(other.size_, {})) {
+		adopt(head_);
+	}
+
+	// 当前链表需为空
+	IntrusiveList& operator=(IntrusiveList&& other) noexcept {
+		head_ = std::exchange(other.head_, {});
+		tail_ = std::exchange(other.tail_, {});
+		size_ = std::exchange(other.size_, {});
+		adopt(head_);
+		return *this;
+	}
+
+	IntrusiveList(const IntrusiveList&) = delete;
+	IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+public:
+	bool empty() const { return head_ == nullptr; }
+	std::size_t size() const { return size_; }
+
+	Node* front() const { return head_; }
+	Node* back() const { return tail_; }
+
+	// 判断节点是否位于当前链表中
+	bool contains(const Node* node) const { return node->list_ == this; }
+
+	void push_back(Node* node) {
+		node->prev_ = tail_;
+		node->next_ = nullptr;
+		node->list_ = this;
+
+		if (tail_) {
+			tail_->next_ = node;
+		} else {
+			head_ = node;
+		}
+
+		tail_ = node;
+		++size_;
+	}
+
+	Node* pop_front() {
+		auto node = head_;
+		if (node) {
+			remove(node);
+		}
+		return node;
+	}
+
+	// 节点必须位于当前链表中
+	void remove(Node* node) {
+		if (node->prev_) {
+			node->prev_->next_ = node->next_;
+		} else {
+			head_ = node->next_;
+		}
+
+		if (node->next_) {
+			node->next_->prev_ = node->prev_;
+		} else {
+			tail_ = node->prev_;
+		}
+
+		node->prev_ = nullptr;
+		node->next_ = nullptr;
+		node->list_ = nullptr;
+		--size_;
+	}
+
+	// 将 other 中所有节点移动至当前链表尾部
+	void splice_back(IntrusiveList& other) {
+		if (other.empty())
+			return;
+
+		adopt(other.head_);
+		if (tail_) {
+			tail_->next_ = other.head_;
+			other.head_->prev_ = tail_;
+		} else {
+			head_ = other.head_;
+		}
+
+		tail_ = other.tail_;
+		size_ += other.size_;
+
+		other.head_ = nullptr;
+		other.tail_ = nullptr;
+		other.size_ = 0;
+	}
+
+private:
+	void adopt(Node* node) {
+		for (; node; node = node->next_) {
+			node->list_ = this;
+		}
+	}
+
+private:
+	Node* head_{};
+	Node* tail_{};
+	std::size_t size_{};
+};
+
+GOCOROUTINE_NAMESPACE_END
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef GOCOROUTINE_RING_BUFFER_H
+#define GOCOROUTINE_RING_BUFFER_H
+
+#include "gocoroutine/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+GOCOROUTINE_NAMESPACE_BEGIN
+
+// 有界无锁环形队列，支持多生产者多消费者
+// 参考 Dmitry Vyukov bounded MPMC queue 实现
+// 每个槽位维护一个序号，生产者/消费者通过 CAS 抢占位置后根据序号判断槽位是否可用
+// 槽位数向上取整为 2 的幂（至少为 2），但队列中的元素个数不超过构造时给定的容量：
+// 容量恰为 2 的幂时由槽位序号保证，否则入队前额外比较出队位置
+// 入队及出队均不进行内存分配
+template <typename T> class MpmcRingBuffer {
+
+public:
+	explicit MpmcRingBuffer(std::size_t capacity)
+	    : capacity_(std::max<std::size_t>(capacity, 1))
+	    , mask_(round_up(capacity_) - 1)
+	    , cells_(std::make_unique<Cell[]>(mask_ + 1)) {
+		for (std::size_t i = 0; i <= mask_; ++i) {
+			cells_[i].sequence_.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	// 析构时不存在并发访问，出队与入队位置之间的元素均已写入，原地析构
+	~MpmcRingBuffer() {
+		auto end = enqueue_pos_.load(std::memory_order_relaxed);
+		for (auto pos = dequeue_pos_.load(std::memory_order_relaxed); pos != end;
+		     ++pos) {
+			std::launder(reinterpret_cast<T*>(cells_[pos & mask_].storage_))->~T();
+		}
+	}
+
+	MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+	MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+public:
+	// 队列已满时返回 false，value 保持不变
+	template <typename U> bool try_push(U&& value) {
+		auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+		Cell* cell;
+
+		while (true) {
+			cell = &cells_[pos & mask_];
+			auto sequence = cell->sequence_.load(std::memory_order_acquire);
+			auto diff = static_cast<std::ptrdiff_t>(sequence) -
+			            static_cast<std::ptrdiff_t>(pos);
+
+			if (diff == 0) {
+				// 出队位置只增不减，此处判断未满则写入后元素个数不会超过 capacity_
+				// pos 过期时差值可能为负，此时交由下面的 CAS 失败重试
+				if (capacity_ <= mask_ &&
+				    static_cast<std::ptrdiff_t>(
+				        pos - dequeue_pos_.load(std::memory_order_acquire)) >=
+				        static_cast<std::ptrdiff_t>(capacity_))
+					return false;
+
+				if (enqueue_pos_.compare_exchange_weak(
+				        pos, pos + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				return false;
+			} else {
+				pos = enqueue_pos_.load(std::memory_order_relaxed);
+			}
+		}
+
+		new (cell->storage_) T(std::forward<U>(value));
+		cell->sequence_.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// 队列为空时返回 std::nullopt，元素直接移动至返回值，T 无需默认构造
+	std::optional<T> try_pop() {
+		auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+		Cell* cell;
+
+		while (true) {
+			cell = &cells_[pos & mask_];
+			auto sequence = cell->sequence_.load(std::memory_order_acquire);
+			auto diff = static_cast<std::ptrdiff_t>(sequence) -
+			            static_cast<std::ptrdiff_t>(pos + 1);
+
+			if (diff == 0) {
+				if (dequeue_pos_.compare_exchange_weak(
+				        pos, pos + 1, std::memory_order_relaxed))
+					break;
+			} else if (diff < 0) {
+				return std::nullopt;
+			} else {
+				pos = dequeue_pos_.load(std::memory_order_relaxed);
+			}
+		}
+
+		auto ptr = std::launder(reinterpret_cast<T*>(cell->storage_));
+		std::optional<T> value(std::move(*ptr));
+		ptr->~T();
+		cell->sequence_.store(pos + mask_ + 1, std::memory_order_release);
+		return value;
+	}
+
+	// 近似判断，仅用于调度决策，并发修改时结果可能立即失效
+	bool empty() const {
+		return enqueue_pos_.load(std::memory_order_acquire) ==
+		       dequeue_pos_.load(std::memory_order_acquire);
+	}
+
+	std::size_t capacity() const { return capacity_; }
+
+private:
+	struct Cell {
+		std::atomic<std::size_t> sequence_{};
+		alignas(T) std::byte storage_[sizeof(T)];
+	};
+
+	static std::size_t round_up(std::size_t capacity) {
+		std::size_t size = 2;
+		while (size < capacity) {
+			size <<= 1;
+		}
+		return size;
+	}
+
+private:
+	static constexpr std::size_t kCacheLineSize = 64;
+
+	std::size_t capacity_{};
+	std::size_t mask_{};
+	std::unique_ptr<Cell[]> cells_{};
+
+	alignas(kCacheLineSize) std::atomic<std::size_t> enqueue_pos_{};
+	alignas(kCacheLineSize) std::atomic<std::size_t> dequeue_pos_{};
+};
+
+// 有界无锁环形队列，仅支持单生产者单消费者
+// 生产者及消费者各自维护位置，并缓存对方的位置，仅在缓存判断为满/空时才读取对方位置
+// 同一时刻至多一个线程入队、一个线程出队，角色可以在线程间转移（需由锁等建立先后关系）
+// 槽位数向上取整为 2 的幂，队列中的元素个数不超过构造时给定的容量
+// 入队及出队均不进行内存分配
+template <typename T> class SpscRingBuffer {
+
+public:
+	explicit SpscRingBuffer(std::size_t capacity)
+	    : capacity_(std::max<std::size_t>(capacity, 1))
+	    , mask_(round_up(capacity_) - 1)
+	    , slots_(std::make_unique<Slot[]>(mask_ + 1)) {}
+
+	// 析构时不存在并发访问，原地析构剩余元素
+	~SpscRingBuffer() {
+		auto tail = tail_.load(std::memory_order_relaxed);
+		for (auto head = head_.load(std::memory_order_relaxed); head != tail;
+		     ++head) {
+			std::launder(reinterpret_cast<T*>(slots_[head & mask_].storage_))->~T();
+		}
+	}
+
+	SpscRingBuffer(const SpscRingBuffer&) = delete;
+	SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+public:
+	// 队列已满时返回 false，value 保持不变
+	template <typename U> bool try_push(U&& value) {
+		auto tail = tail_.load(std::memory_order_relaxed);
+
+		if (tail - cached_head_ >= capacity_) {
+			cached_head_ = head_.load(std::memory_order_acquire);
+			if (tail - cached_head_ >= capacity_)
+				return false;
+		}
+
+		new (slots_[tail & mask_].storage_) T(std::forward<U>(value));
+		tail_.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// 队列为空时返回 std::nullopt
+	std::optional<T> try_pop() {
+		auto head = head_.load(std::memory_order_relaxed);
+
+		if (head == cached_tail_) {
+			cached_tail_ = tail_.load(std::memory_order_acquire);
+			if (head == cached_tail_)
+				return std::nullopt;
+		}
+
+		auto ptr =
+		    std::launder(reinterpret_cast<T*>(slots_[head & mask_].storage_));
+		std::optional<T> value(std::move(*ptr));
+		ptr->~T();
+		head_.store(head + 1, std::memory_order_release);
+		return value;
+	}
+
+	// 近似判断，仅用于调度决策，并发修改时结果可能立即失效
+	bool empty() const {
+		return tail_.load(std::memory_order_acquire) ==
+		       head_.load(std::memory_order_acquire);
+	}
+
+	std::size_t capacity() const { return capacity_; }
+
+private:
+	struct Slot {
+		alignas(T) std::byte storage_[sizeof(T)];
+	};
+
+	static std::size_t round_up(std::size_t capacity) {
+		std::size_t size = 2;
+		while (size < capacity) {
+			size <<= 1;
+		}
+		return size;
+	}
+
+private:
+	static constexpr std::size_t kCacheLineSize = 64;
+
+	std::size_t capacity_{};
+	std::size_t mask_{};
+	std::unique_ptr<Slot[]> slots_{};
+
+	// 生产者使用
+	alignas(kCacheLineSize) std::atomic<std::size_t> tail_{};
+	std::size_t cached_head_{};
+
+	// 消费者使用
+	alignas(kCacheLineSize) std::atomic<std::size_t> head_{};
+	std::size_t cached_tail_{};
+};
+
+GOCOROUTINE_NAMESPACE_END
+
+#endif
@@ -1,75 +1,39 @@
 #ifndef GOCOROUTINE_SCHEDULER_H
 #define GOCOROUTINE_SCHEDULER_H
 
+#include "gocoroutine/intrusive_list.h"
+#include "gocoroutine/timing_wheel.h"
 #include "gocoroutine/utils.h"
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <functional>
-#include <memory>
+#include <limits>
 #include <mutex>
-#include <queue>
+#include <thread>
 #include <utility>
-#include <vector>
 
 GOCOROUTINE_NAMESPACE_BEGIN
 
-// 此处设计为定时事件（即将任务与时间戳进行绑定，从而实现一个毫秒级别的延时）
-// 采用 operator() 重载，实现对于任务的调用
-class DelayedExecutable {
-
-public:
-	// 构造函数，将任务与时间戳进行绑定
-	DelayedExecutable(std::function<void()>&& func, long long delay)
-	    : func_(func) {
-		auto now = std::chrono::system_clock::now();
-		auto current = std::chrono::duration_cast<std::chrono::milliseconds>(
-		                   now.time_since_epoch())
-		                   .count();
-		scheduler_time_ = current + delay;
-	}
-
-public:
-	// 延时函数，计算剩余时间
-	int64_t delay() const { /* NOLINT */
-		auto now = std::chrono::system_clock::now();
-		auto current = std::chrono::duration_cast<std::chrono::milliseconds>(
-		                   now.time_since_epoch())
-		                   .count();
-		return scheduler_time_ - current;
-	}
-
-	// 返回执行时间戳
-	int64_t get_scheduled_time() const { /* NOLINT */
-		return scheduler_time_;
-	}
-
-	// operator() 重载，实现对于定时任务的调用
-	void operator()() { func_(); }
-
-private:
-	int64_t scheduler_time_{};     // 调度时间戳
-	std::function<void()> func_{}; // 延时执行函数
-};
-
-// DelayedExecutableCompare 类，用于实现 DelayedExecutable 类的比较
-// 定义了 operator() 重载，用于比较 DelayedExecutable 类的调度时间戳
-// 调度时间戳越小的，优先级越高
-class DelayedExecutableCompare {
-public:
-	bool operator()(DelayedExecutable& left, DelayedExecutable& right) {
-		return left.get_scheduled_time() > right.get_scheduled_time();
-	}
-};
-
 // 这里相当于一个定时调度器的实现
 // executor LoopExexutor
-// 的基础上，使用优先级队列（通过重载时间戳比较函数）实现按剩余等待时间的排序
-// 使用条件变量 condition_variable 实现阻塞至等待时间位置
+// 的基础上，使用分层时间轮（TimingWheel）按毫秒 tick 管理定时事件，插入为 O(1)
+// 到期时间统一为 steady_clock 纳秒，不受系统时间调整影响，也不截断到毫秒
+// 使用条件变量 condition_variable 实现阻塞至下一个到期时间，到期事件批量执行
 class Scheduler {
 
 public:
-	Scheduler() {
+	// 时间轮 tick 长度，单位纳秒，仅影响分桶粒度，不影响到期精度
+	static constexpr int64_t kTickDuration = 1000000;
+
+public:
+	// slack 为默认的定时合并窗口，到期时间相近的定时事件合并为一次唤醒，最多延后 slack
+	// 参考 Linux timer slack，默认为 0，即按精确时间到期
+	explicit Scheduler(
+	    std::chrono::nanoseconds slack = std::chrono::nanoseconds::zero())
+	    : timing_wheel_(current_time(), kTickDuration)
+	    , slack_(slack.count()) {
 		is_active_.store(true, std::memory_order_relaxed);
 		work_thread_ = std::thread(&Scheduler::run_loop, this);
 	}
@@ -81,39 +45,71 @@ public:
 
 public:
 	// 此处实现基本与 LoopExexutor 相同，此处省略注释
-	void execute(std::function<void()>&& func, int64_t delay) {
-		delay = delay < 0 ? 0 : delay;
-		std::unique_lock<std::mutex> lock(queue_mutex_);
+	// delay 单位为毫秒
+	// 返回的句柄可用于在到期前取消，关闭后提交的定时事件返回空句柄
+	TimerHandle execute(std::function<void()>&& func, int64_t delay) {
+		return execute(std::move(func), std::chrono::milliseconds(delay));
+	}
 
-		if (is_active_.load(std::memory_order_relaxed)) {
-			bool need_notify = executable_queue_.empty() ||
-			                   executable_queue_.top().delay() > delay;
-			executable_queue_.emplace(std::move(func), delay);
-			lock.unlock();
+	// 任意精度的延时，向上取整到纳秒，使用默认的定时合并窗口
+	template <typename Rep_, typename Period_>
+	TimerHandle execute(std::function<void()>&& func,
+	                    std::chrono::duration<Rep_, Period_> delay) {
+		return add_timer(std::move(func), to_nanoseconds(delay), 0,
+		                 PeriodicPolicy::kFixedRate,
+		                 slack_.load(std::memory_order_relaxed));
+	}
 
-			if (need_notify) {
-				queue_condition_.notify_all();
-			}
-		}
+	// 单独指定定时合并窗口，对延时精度要求不同的定时事件可以共用同一调度器
+	template <typename Rep_, typename Period_>
+	TimerHandle execute(std::function<void()>&& func,
+	                    std::chrono::duration<Rep_, Period_> delay,
+	                    std::chrono::nanoseconds slack) {
+		return add_timer(std::move(func), to_nanoseconds(delay), 0,
+		                 PeriodicPolicy::kFixedRate, slack.count());
+	}
+
+	// 周期定时事件，首次在一个周期后到期，此后复用同一定时事件重新调度
+	// 返回的句柄可随时取消，执行期间取消则在本次执行完毕后不再调度
+	template <typename Rep_, typename Period_>
+	TimerHandle
+	schedule_periodic(std::function<void()>&& func,
+	                  std::chrono::duration<Rep_, Period_> period,
+	                  PeriodicPolicy policy = PeriodicPolicy::kFixedRate) {
+		int64_t period_time = to_nanoseconds(period);
+		period_time = period_time < 1 ? 1 : period_time;
+		return add_timer(std::move(func), period_time, period_time, policy,
+		                 slack_.load(std::memory_order_relaxed));
 	}
 
+	// 修改默认的定时合并窗口，仅影响此后添加的定时事件
+	void set_slack(std::chrono::nanoseconds slack) {
+		slack_.store(slack.count(), std::memory_order_relaxed);
+	}
+
+	// 关闭后周期定时事件不再调度，等待完成时仅等待剩余的一次性定时事件
 	void shutdown(bool wait_for_complete = true) {
 
 		if (!is_active_.load(std::memory_order_relaxed))
 			return;
 
+		std::unique_lock<std::mutex> lock(queue_mutex_);
 		is_active_.store(false, std::memory_order_relaxed);
+		timing_wheel_.cancel_periodic();
 
 		if (!wait_for_complete) {
 
-			// 清空任务队列
-			std::unique_lock<std::mutex> lock(queue_mutex_);
-			std::exchange(executable_queue_, {});
-			lock.unlock();
-
-			// 唤醒所有阻塞线程
-			queue_condition_.notify_all();
+			// 清空时间轮
+			IntrusiveList<DelayedExecutable> expired;
+			timing_wheel_.advance(std::numeric_limits<int64_t>::max() - 1,
+			                      expired);
+			timing_wheel_.release(expired);
 		}
+
+		lock.unlock();
+
+		// 唤醒所有阻塞线程
+		queue_condition_.notify_all();
 	}
 
 	void join() {
@@ -122,48 +118,103 @@ public:
 		}
 	}
 
+	// 全局共享的定时调度器，供未自行管理定时事件的执行器使用
+	static Scheduler& shared() {
+		static Scheduler scheduler;
+		return scheduler;
+	}
+
+	// 当前单调时间，单位纳秒
+	static int64_t current_time() {
+		auto now = std::chrono::steady_clock::now();
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		           now.time_since_epoch())
+		    .count();
+	}
+
 private:
+	template <typename Rep_, typename Period_>
+	static int64_t to_nanoseconds(std::chrono::duration<Rep_, Period_> delay) {
+		return std::chrono::ceil<std::chrono::nanoseconds>(delay).count();
+	}
+
+	// 添加定时事件，period 为 0 时为一次性定时事件
+	TimerHandle add_timer(std::function<void()>&& func, int64_t delay_time,
+	                      int64_t period, PeriodicPolicy policy,
+	                      int64_t slack) {
+		delay_time = delay_time < 0 ? 0 : delay_time;
+		slack = slack < 0 ? 0 : slack;
+		std::unique_lock<std::mutex> lock(queue_mutex_);
+
+		if (!is_active_.load(std::memory_order_relaxed))
+			return {};
+
+		int64_t expire_time = current_time() + delay_time;
+		auto node = period > 0
+		                ? timing_wheel_.add_periodic(std::move(func), expire_time,
+		                                             period, policy, slack)
+		                : timing_wheel_.add(std::move(func), expire_time, slack);
+		auto handle =
+		    TimerHandle(&queue_mutex_, &timing_wheel_, node, node->get_id());
+
+		// 仅当新事件早于执行线程当前的唤醒时间时才需要唤醒
+		bool need_notify = node->get_fire_time() < wakeup_time_;
+		lock.unlock();
+
+		if (need_notify) {
+			queue_condition_.notify_all();
+		}
+
+		return handle;
+	}
+
 	// 此处 Scheduler 与 LoopExecutor 区别主要体现在此处
-	// 增加基于优先级队列及条件变量实现的定时逻辑
+	// 增加基于时间轮及条件变量实现的定时逻辑
 	void run_loop() {
-		while (is_active_.load(std::memory_order_relaxed) ||
-		       !executable_queue_.empty()) {
+		IntrusiveList<DelayedExecutable> expired;
 
+		while (true) {
 			std::unique_lock<std::mutex> lock(queue_mutex_);
 
-			// 当任务队列为空时，执行阻塞
-			if (executable_queue_.empty()) {
-				queue_condition_.wait(lock);
-				if (executable_queue_.empty()) {
-					continue;
-				}
-			}
+			// 取出所有到期事件
+			timing_wheel_.advance(current_time(), expired);
 
-			// 获取当前最近任务
-			auto executable = executable_queue_.top();
-			int64_t delay = executable.delay();
+			if (expired.empty()) {
+				int64_t next_time = timing_wheel_.next_time();
 
-			// 未到执行时间
-			if (delay > 0) {
+				// 时间轮为空，关闭后退出，否则阻塞等待新事件
+				if (next_time < 0) {
+					if (!is_active_.load(std::memory_order_relaxed))
+						break;
 
-				// 按当前最近时间进行阻塞，直到到执行时间
-				auto status = queue_condition_.wait_for(
-				    lock, std::chrono::milliseconds(delay));
+					wakeup_time_ = std::numeric_limits<int64_t>::max();
+					queue_condition_.wait(lock);
+				} else {
 
-				// 判断唤醒状态
-				// 当为超时，说明到最近任务执行时间了，直接向下执行至后续调用
-				// func 逻辑 当不为超时，说明有其他任务到来唤醒，因此直接
-				// continue 重新执行逻辑比较等
-				if (status != std::cv_status::timeout) {
-					continue;
+					// 按下一个到期时间进行阻塞
+					// 超时或有更早事件到来被唤醒后，均重新计算到期事件
+					wakeup_time_ = next_time;
+					queue_condition_.wait_until(
+					    lock, std::chrono::steady_clock::time_point(
+					              std::chrono::nanoseconds(next_time)));
 				}
+
+				wakeup_time_ = std::numeric_limits<int64_t>::min();
+				continue;
 			}
 
-			// 执行任务
-			executable_queue_.pop();
 			lock.unlock();
 
-			executable();
+			// 批量执行到期事件，执行完毕后统一回收，周期事件重新调度
+			IntrusiveList<DelayedExecutable> finished;
+			while (auto executable = expired.pop_front()) {
+				(*executable)();
+				finished.push_back(executable);
+			}
+
+			lock.lock();
+			timing_wheel_.complete(finished, current_time(),
+			                       is_active_.load(std::memory_order_relaxed));
 		}
 
 		// DEBUGFMTLOG("timer run loop exit!");
@@ -172,9 +223,13 @@ private:
 private:
 	std::condition_variable queue_condition_{};
 	std::mutex queue_mutex_{};
-	std::priority_queue<DelayedExecutable, std::vector<DelayedExecutable>,
-	                    DelayedExecutableCompare>
-	    executable_queue_{};
+	TimingWheel timing_wheel_;
+
+	// 执行线程当前阻塞至的时间，执行任务期间为最小值，新事件无需唤醒
+	int64_t wakeup_time_{std::numeric_limits<int64_t>::min()};
+
+	// 默认的定时合并窗口，单位纳秒
+	std::atomic<int64_t> slack_{};
 
 	std::atomic<bool> is_active_{};
 	std::thread work_thread_{};
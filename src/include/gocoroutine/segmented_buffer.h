@@ -0,0 +1,211 @@
+#ifndef GOCOROUTINE_SEGMENTED_BUFFER_H
+#define GOCOROUTINE_SEGMENTED_BUFFER_H
+
+#include "gocoroutine/utils.h"
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <utility>
+
+GOCOROUTINE_NAMESPACE_BEGIN
+
+// 无界队列，由定长分段链接而成，支持多生产者多消费者
+// 生产者与消费者分别持有尾部锁与头部锁（two-lock queue），二者互不竞争
+// 读完的分段放回空闲链表供生产者复用，稳态下入队及出队均不进行内存分配；
+// 空闲分段不释放，内存占用保持在突发峰值，峰值可通过 high_water_mark() 观察
+template <typename T> class SegmentedBuffer {
+
+public:
+	// Channel 据此在 capacity 为 0 时依然创建缓冲区
+	static constexpr bool kUnbounded = true;
+	static constexpr std::size_t kDefaultSegmentSize = 64;
+
+	// segment_size 为每个分段的元素个数，为 0 时使用默认值
+	explicit SegmentedBuffer(std::size_t segment_size = 0)
+	    : segment_size_(segment_size > 0 ? segment_size : kDefaultSegmentSize) {
+		head_ = tail_ = allocate_segment();
+	}
+
+	// 析构时不存在并发访问，从读取位置起原地析构各分段中剩余的元素
+	~SegmentedBuffer() {
+		auto pos = head_pos_;
+		for (auto segment = head_; segment;
+		     segment = segment->next_.load(std::memory_order_relaxed)) {
+			auto end = segment->published_.load(std::memory_order_relaxed);
+			for (; pos < end; ++pos) {
+				std::launder(reinterpret_cast<T*>(segment->slots_[pos].storage_))
+				    ->~T();
+			}
+			pos = 0;
+		}
+
+		delete_segments(head_);
+		delete_segments(free_list_);
+	}
+
+	SegmentedBuffer(const SegmentedBuffer&) = delete;
+	SegmentedBuffer& operator=(const SegmentedBuffer&) = delete;
+
+public:
+	// 总是成功，当前分段写满时链接新的分段
+	template <typename U> bool try_push(U&& value) {
+		std::lock_guard<std::mutex> lk(tail_mutex_);
+
+		auto pos = tail_->published_.load(std::memory_order_relaxed);
+		if (pos == segment_size_) {
+			auto segment = acquire_segment();
+			tail_->next_.store(segment, std::memory_order_release);
+			tail_ = segment;
+			pos = 0;
+		}
+
+		new (tail_->slots_[pos].storage_) T(std::forward<U>(value));
+
+		// 计数须在发布之前增加，否则消费者可能先读走该元素并减计数，size_ 下溢
+		// 高水位仅由生产者在尾部锁内更新，且先于计数增加，读到的 size() 不超过 high_water_mark()
+		auto size = size_.load(std::memory_order_relaxed) + 1;
+		if (size > high_water_mark_.load(std::memory_order_relaxed)) {
+			high_water_mark_.store(size, std::memory_order_relaxed);
+		}
+		size_.fetch_add(1, std::memory_order_release);
+
+		tail_->published_.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	// 队列为空时返回 std::nullopt，元素直接移动至返回值，T 无需默认构造
+	std::optional<T> try_pop() {
+		std::lock_guard<std::mutex> lk(head_mutex_);
+
+		// 当前分段已读完，生产者已链接下一个分段时才能前进
+		if (head_pos_ == segment_size_) {
+			auto next = head_->next_.load(std::memory_order_acquire);
+			if (!next)
+				return std::nullopt;
+
+			release_segment(std::exchange(head_, next));
+			head_pos_ = 0;
+		}
+
+		if (head_pos_ == head_->published_.load(std::memory_order_acquire))
+			return std::nullopt;
+
+		auto ptr = std::launder(
+		    reinterpret_cast<T*>(head_->slots_[head_pos_].storage_));
+		std::optional<T> value(std::move(*ptr));
+		ptr->~T();
+		++head_pos_;
+
+		size_.fetch_sub(1, std::memory_order_relaxed);
+		return value;
+	}
+
+	// 近似判断，仅用于调度决策，并发修改时结果可能立即失效
+	bool empty() const { return size() == 0; }
+
+	std::size_t capacity() const {
+		return std::numeric_limits<std::size_t>::max();
+	}
+
+public:
+	// 以下为统计信息，并发修改时均为近似值
+
+	// 当前元素个数，可能短暂多计正在发布的元素，但不会小于 0
+	std::size_t size() const { return size_.load(std::memory_order_acquire); }
+
+	// 元素个数的历史峰值，即最大突发的大小
+	std::size_t high_water_mark() const {
+		return high_water_mark_.load(std::memory_order_relaxed);
+	}
+
+	// 将峰值重置为当前元素个数，用于按时间段统计
+	void reset_high_water_mark() {
+		std::lock_guard<std::mutex> lk(tail_mutex_);
+		high_water_mark_.store(size(), std::memory_order_relaxed);
+	}
+
+	// 已分配的分段个数（含空闲分段）
+	std::size_t segment_count() const {
+		return segment_count_.load(std::memory_order_relaxed);
+	}
+
+	std::size_t segment_size() const { return segment_size_; }
+
+private:
+	struct Slot {
+		alignas(T) std::byte storage_[sizeof(T)];
+	};
+
+	struct Segment {
+		explicit Segment(std::size_t size)
+		    : slots_(std::make_unique<Slot[]>(size)) {}
+
+		std::unique_ptr<Slot[]> slots_;
+		std::atomic<std::size_t> published_{}; // 已写入的元素个数
+		std::atomic<Segment*> next_{};
+	};
+
+	Segment* allocate_segment() {
+		segment_count_.fetch_add(1, std::memory_order_relaxed);
+		return new Segment(segment_size_);
+	}
+
+	// 生产者在尾部锁内调用，优先复用空闲分段
+	Segment* acquire_segment() {
+		{
+			std::lock_guard<std::mutex> lk(free_mutex_);
+			if (auto segment = free_list_) {
+				free_list_ = segment->next_.load(std::memory_order_relaxed);
+				segment->next_.store(nullptr, std::memory_order_relaxed);
+				return segment;
+			}
+		}
+
+		return allocate_segment();
+	}
+
+	// 消费者在头部锁内调用，分段中的元素均已读完且生产者已不再访问
+	void release_segment(Segment* segment) {
+		segment->published_.store(0, std::memory_order_relaxed);
+
+		std::lock_guard<std::mutex> lk(free_mutex_);
+		segment->next_.store(free_list_, std::memory_order_relaxed);
+		free_list_ = segment;
+	}
+
+	static void delete_segments(Segment* segment) {
+		while (segment) {
+			delete std::exchange(
+			    segment, segment->next_.load(std::memory_order_relaxed));
+		}
+	}
+
+private:
+	static constexpr std::size_t kCacheLineSize = 64;
+
+	const std::size_t segment_size_;
+
+	// 消费者使用
+	alignas(kCacheLineSize) std::mutex head_mutex_{};
+	Segment* head_{};
+	std::size_t head_pos_{};
+
+	// 生产者使用
+	alignas(kCacheLineSize) std::mutex tail_mutex_{};
+	Segment* tail_{};
+
+	std::mutex free_mutex_{};
+	Segment* free_list_{};
+
+	alignas(kCacheLineSize) std::atomic<std::size_t> size_{};
+	std::atomic<std::size_t> high_water_mark_{};
+	std::atomic<std::size_t> segment_count_{};
+};
+
+GOCOROUTINE_NAMESPACE_END
+
+#endif
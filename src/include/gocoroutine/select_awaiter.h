@@ -0,0 +1,398 @@
+#ifndef GOCOROUTINE_SELECT_AWAITER_H
+#define GOCOROUTINE_SELECT_AWAITER_H
+
+#include "gocoroutine/channel_awaiter.h"
+#include "gocoroutine/executor.h"
+#include "gocoroutine/scheduler.h"
+#include "gocoroutine/timing_wheel.h"
+#include "gocoroutine/utils.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+GOCOROUTINE_NAMESPACE_BEGIN
+
+// select 的读分支，读到的值通过 value() 获取（仅在该分支被选中后有效），
+// 或直接移动至 case_read 传入的目标变量
+template <typename T, typename Channel_> class ReadCase {
+
+public:
+	using Reader = typename Channel_::Reader;
+	using Writer = typename Channel_::Writer;
+
+	explicit ReadCase(Channel_* channel, T* target = nullptr)
+	    : channel_(channel)
+	    , node_(channel) {
+		node_.p_value_ = target;
+	}
+
+	ReadCase(ReadCase&& other) noexcept = default;
+
+public:
+	T& value() { return *node_.value_; }
+
+	std::mutex* mutex() { return &channel_->select_mutex(); }
+	void prepare() { channel_->select_prepare(); }
+	void cancel_prepare() { channel_->select_cancel_prepare(); }
+	bool poll() { return channel_->select_read(&node_, partner_); }
+
+	void park(SelectClaim* claim, int index) {
+		node_.claim_ = claim;
+		node_.case_index_ = index;
+		node_.handle_ = claim->handle_;
+		node_.executor_ = claim->executor_;
+		channel_->select_park_reader(&node_);
+	}
+
+	// 不持有锁时调用，已被 channel 取出的节点不在链表中，remove 无操作
+	void unpark() { channel_->remove_reader(&node_); }
+
+	void detach() { node_.channel_ = nullptr; }
+
+	void complete() {
+		if (auto partner = std::exchange(partner_, nullptr)) {
+			partner->resume();
+		}
+		channel_->select_notify();
+	}
+
+	// channel 关闭且缓冲区已读完时抛出异常
+	void check() {
+		if (node_.closed_ && !channel_->try_read_into(&node_))
+			channel_->check_closed();
+	}
+
+private:
+	Channel_* channel_{};
+	Reader node_;
+	Writer* partner_{};
+};
+
+template <typename T, typename Channel_> class WriteCase {
+
+public:
+	using Reader = typename Channel_::Reader;
+	using Writer = typename Channel_::Writer;
+
+	WriteCase(Channel_* channel, T value)
+	    : channel_(channel)
+	    , node_(channel, std::move(value)) {}
+
+	WriteCase(WriteCase&& other) noexcept = default;
+
+public:
+	std::mutex* mutex() { return &channel_->select_mutex(); }
+	void prepare() { channel_->select_prepare(); }
+	void cancel_prepare() { channel_->select_cancel_prepare(); }
+	bool poll() { return channel_->select_write(&node_, partner_); }
+
+	void park(SelectClaim* claim, int index) {
+		node_.claim_ = claim;
+		node_.case_index_ = index;
+		node_.handle_ = claim->handle_;
+		node_.executor_ = claim->executor_;
+		channel_->select_park_writer(&node_);
+	}
+
+	void unpark() { channel_->remove_writer(&node_); }
+
+	void detach() { node_.channel_ = nullptr; }
+
+	void complete() {
+		if (auto partner = std::exchange(partner_, nullptr)) {
+			partner->resume();
+		}
+		channel_->select_notify();
+	}
+
+	void check() {
+		if (node_.closed_)
+			channel_->check_closed();
+	}
+
+private:
+	Channel_* channel_{};
+	Writer node_;
+	Reader* partner_{};
+};
+
+// 超时分支，所有 channel 分支在 duration_ 内均未就绪时选中
+struct TimeoutCase {
+	std::chrono::nanoseconds duration_{};
+};
+
+// 默认分支，所有 channel 分支均未就绪时立即选中，不挂起
+struct DefaultCase {};
+
+template <typename Channel_>
+auto case_read(Channel_& channel) {
+	using T = typename Channel_::value_type;
+	return ReadCase<T, Channel_>(&channel);
+}
+
+template <typename Channel_>
+auto case_read(Channel_& channel, typename Channel_::value_type& target) {
+	using T = typename Channel_::value_type;
+	return ReadCase<T, Channel_>(&channel, &target);
+}
+
+template <typename Channel_>
+auto case_write(Channel_& channel, typename Channel_::value_type value) {
+	using T = typename Channel_::value_type;
+	return WriteCase<T, Channel_>(&channel, std::move(value));
+}
+
+template <typename Rep_, typename Period_>
+TimeoutCase case_timeout(std::chrono::duration<Rep_, Period_> duration) {
+	return TimeoutCase{std::chrono::ceil<std::chrono::nanoseconds>(duration)};
+}
+
+inline constexpr DefaultCase default_case{};
+
+// 多路等待，参考 Go 中的 select，co_await 返回被选中分支的序号
+// 先在所有相关 channel 的锁内按顺序轮询各分支，有就绪分支时立即完成，
+// 否则存在默认分支时选中默认分支，否则将各分支的节点挂入对应 channel 的等待链表，
+// 由最先完成的 channel（或超时定时器）通过共享的 SelectClaim 认领并恢复协程，
+// 恢复后再将其余节点移出等待链表
+// 因 channel 关闭而选中时：读分支在缓冲区读完后、写分支立即抛出 ChannelClosedException
+//
+// 分支对象以引用保存，使用临时对象时在整个 co_await 表达式内有效：
+//   switch (co_await select(case_read(a), case_read(b, value), case_timeout(1s))) { ... }
+template <typename... Cases_> class SelectAwaiter {
+
+	static constexpr std::size_t kCaseCount = sizeof...(Cases_);
+
+	static constexpr std::size_t kTimeoutCount =
+	    (std::size_t(std::is_same_v<std::remove_cv_t<Cases_>, TimeoutCase>) + ... +
+	     0);
+	static constexpr std::size_t kDefaultCount =
+	    (std::size_t(std::is_same_v<std::remove_cv_t<Cases_>, DefaultCase>) + ... +
+	     0);
+
+	static_assert(kCaseCount > 0, "select requires at least one case");
+	static_assert(kTimeoutCount <= 1, "select allows at most one timeout case");
+	static_assert(kDefaultCount <= 1, "select allows at most one default case");
+
+	template <typename Case_>
+	static constexpr bool is_channel_case =
+	    !std::is_same_v<Case_, TimeoutCase> && !std::is_same_v<Case_, DefaultCase>;
+
+	using MutexArray = std::array<std::mutex*, kCaseCount>;
+
+public:
+	explicit SelectAwaiter(Cases_&... cases)
+	    : cases_(cases...) {}
+
+	SelectAwaiter(SelectAwaiter&& other) noexcept
+	    : executor_(other.executor_)
+	    , cases_(other.cases_) {}
+
+	~SelectAwaiter() {
+
+		// 挂起期间协程被销毁
+		if (suspended_) {
+			unpark_all();
+		}
+	}
+
+	SelectAwaiter(const SelectAwaiter&) = delete;
+	SelectAwaiter& operator=(const SelectAwaiter&) = delete;
+
+public:
+	bool await_ready() { return false; }
+
+	bool await_suspend(std::coroutine_handle<> handle) {
+
+		auto mutexes = collect_mutexes();
+		lock_all(mutexes);
+
+		for_each_case([](auto& select_case, int) {
+			if constexpr (is_channel_case<std::decay_t<decltype(select_case)>>)
+				select_case.prepare();
+		});
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		auto ready = poll_all();
+		if (ready >= 0) {
+			for_each_case([](auto& select_case, int) {
+				if constexpr (is_channel_case<std::decay_t<decltype(select_case)>>) {
+					select_case.cancel_prepare();
+					select_case.detach();
+				}
+			});
+			unlock_all(mutexes);
+
+			selected_ = ready;
+			for_each_case([ready](auto& select_case, int index) {
+				if constexpr (is_channel_case<std::decay_t<decltype(select_case)>>) {
+					if (index == ready)
+						select_case.complete();
+				}
+			});
+			return false;
+		}
+
+		// 存在超时分支时定时回调可能晚于协程恢复执行，认领状态由回调共同持有
+		if constexpr (kTimeoutCount > 0) {
+			shared_claim_ = std::make_shared<SelectClaim>();
+			claim_ = shared_claim_.get();
+		} else {
+			claim_ = &local_claim_;
+		}
+
+		claim_->handle_ = handle;
+		claim_->executor_ = executor_;
+		suspended_ = true;
+
+		if constexpr (kTimeoutCount > 0) {
+
+			// 持有认领直至定时器登记完成，保证 timer_ 写入先于回调恢复协程
+			// 定时器由所属执行器管理，自行管理定时事件的执行器不经过全局定时线程
+			// 登记时持有 kBusy 获取定时器锁，安全性见 SelectClaim
+			claim_->acquire();
+			for_each_case([this](auto& select_case, int index) {
+				if constexpr (std::is_same_v<std::decay_t<decltype(select_case)>,
+				                             TimeoutCase>) {
+					auto on_timeout = [claim = shared_claim_, index]() {
+						if (claim->try_claim(index)) {
+							claim->resume();
+						}
+					};
+
+					timer_ = executor_ ? executor_->execute_after(
+					                         on_timeout, select_case.duration_)
+					                   : Scheduler::shared().execute(
+					                         on_timeout, select_case.duration_);
+				}
+			});
+		}
+
+		for_each_case([this](auto& select_case, int index) {
+			if constexpr (is_channel_case<std::decay_t<decltype(select_case)>>)
+				select_case.park(claim_, index);
+		});
+
+		if constexpr (kTimeoutCount > 0) {
+			claim_->release();
+		}
+
+		// 释放锁后协程可能已被恢复，不能再访问 this
+		unlock_all(mutexes);
+		return true;
+	}
+
+	int await_resume() {
+		if (suspended_) {
+			selected_ = claim_->index();
+			unpark_all();
+		}
+
+		for_each_case([this](auto& select_case, int index) {
+			if constexpr (is_channel_case<std::decay_t<decltype(select_case)>>) {
+				if (index == selected_)
+					select_case.check();
+			}
+		});
+
+		return selected_;
+	}
+
+public:
+	AbstractExecutor* executor_{};
+
+private:
+	template <typename Func> void for_each_case(Func&& func) {
+		for_each_case(std::forward<Func>(func),
+		              std::index_sequence_for<Cases_...>{});
+	}
+
+	template <typename Func, std::size_t... Index>
+	void for_each_case(Func&& func, std::index_sequence<Index...>) {
+		(func(std::get<Index>(cases_), int(Index)), ...);
+	}
+
+	MutexArray collect_mutexes() {
+		MutexArray mutexes{};
+		for_each_case([&mutexes](auto& select_case, int index) {
+			if constexpr (is_channel_case<std::decay_t<decltype(select_case)>>)
+				mutexes[index] = select_case.mutex();
+		});
+
+		// 按地址顺序加锁，同一 channel 的多个分支只加锁一次
+		std::sort(mutexes.begin(), mutexes.end(), std::less<std::mutex*>());
+		std::fill(std::unique(mutexes.begin(), mutexes.end()), mutexes.end(),
+		          nullptr);
+		return mutexes;
+	}
+
+	static void lock_all(const MutexArray& mutexes) {
+		for (auto mutex : mutexes) {
+			if (mutex)
+				mutex->lock();
+		}
+	}
+
+	static void unlock_all(const MutexArray& mutexes) {
+		for (auto mutex : mutexes) {
+			if (mutex)
+				mutex->unlock();
+		}
+	}
+
+	// 按分支顺序轮询，返回第一个就绪分支的序号，均未就绪时返回默认分支或 -1
+	int poll_all() {
+		int ready = -1;
+		int fallback = -1;
+		for_each_case([&ready, &fallback](auto& select_case, int index) {
+			using Case = std::decay_t<decltype(select_case)>;
+			if constexpr (std::is_same_v<Case, DefaultCase>) {
+				fallback = index;
+			} else if constexpr (is_channel_case<Case>) {
+				if (ready < 0 && select_case.poll())
+					ready = index;
+			}
+		});
+
+		return ready >= 0 ? ready : fallback;
+	}
+
+	void unpark_all() {
+		for_each_case([](auto& select_case, int) {
+			if constexpr (is_channel_case<std::decay_t<decltype(select_case)>>) {
+				select_case.unpark();
+				select_case.detach();
+			}
+		});
+
+		timer_.cancel();
+		suspended_ = false;
+	}
+
+private:
+	std::tuple<Cases_&...> cases_;
+
+	int selected_{-1};
+	bool suspended_{};
+
+	SelectClaim* claim_{};
+	SelectClaim local_claim_{};
+	std::shared_ptr<SelectClaim> shared_claim_{};
+	TimerHandle timer_{};
+};
+
+template <typename... Cases_>
+SelectAwaiter<std::remove_reference_t<Cases_>...> select(Cases_&&... cases) {
+	return SelectAwaiter<std::remove_reference_t<Cases_>...>(cases...);
+}
+
+GOCOROUTINE_NAMESPACE_END
+
+#endif
@@ -2,39 +2,30 @@
 #define GOCOROUTINE_SLEEP_AWAITER_H
 
 #include "gocoroutine/executor.h"
-#include "gocoroutine/scheduler.h"
 #include "gocoroutine/utils.h"
-#include <cstdint>
+#include <chrono>
 
 GOCOROUTINE_NAMESPACE_BEGIN
 
 class SleepAwaiter {
 public:
-	SleepAwaiter(AbstractExecutor* executor, int64_t duration)
+	SleepAwaiter(AbstractExecutor* executor, std::chrono::nanoseconds duration)
 	    : executor_(executor)
 	    , duration_(duration) {}
 
 public:
 	constexpr bool await_ready() { return false; }  /* NOLINT */
 
+	// 由执行器管理定时事件，到期后恢复协程
 	void await_suspend(std::coroutine_handle<> handle) {
-
-		static Scheduler scheduler;
-
-		scheduler.execute(
-		    [this, handle]() {
-			    executor_->execute(
-					[handle]() { 
-						handle.resume(); });
-		    },
-		    duration_);
+		executor_->schedule_after(handle, duration_);
 	}
 
 	void await_resume() {}
 
 private:
 	AbstractExecutor* executor_{};
-	int64_t duration_{};
+	std::chrono::nanoseconds duration_{};
 };
 
 GOCOROUTINE_NAMESPACE_END
@@ -3,17 +3,18 @@
 
 #include "gocoroutine/dispatch_awaiter.h"
 #include "gocoroutine/executor.h"
+#include "gocoroutine/frame_allocator.h"
 #include "gocoroutine/result.h"
+#include "gocoroutine/select_awaiter.h"
 #include "gocoroutine/sleep_awaiter.h"
 #include "gocoroutine/task_awaiter.h"
+#include "gocoroutine/task_completion.h"
+#include "gocoroutine/ticker.h"
 #include "gocoroutine/channel_awaiter.h"
 #include "gocoroutine/utils.h"
-#include <condition_variable>
+#include <chrono>
 #include <exception>
 #include <functional>
-#include <list>
-#include <mutex>
-#include <optional>
 #include <type_traits>
 #include <utility>
 
@@ -24,23 +25,64 @@ GOCOROUTINE_NAMESPACE_BEGIN
 // 此后即可在外部函数中对该协程进行切换等操作
 // 参考 https://zhuanlan.zhihu.com/p/615828280
 
+// 可绑定调度器的 awaiter，即带有 AbstractExecutor* executor_ 成员
+// 如 channel 读写、select、周期触发器等，恢复协程时经由该调度器
+template <typename Awaiter_>
+concept ExecutorBoundAwaiter =
+    requires(std::remove_cvref_t<Awaiter_>& awaiter, AbstractExecutor* executor) {
+	    awaiter.executor_ = executor;
+    };
+
+// Task 及其 void 特化的 promise 共用部分：协程帧分配、所属调度器及 await 转换
+// 继承 FrameAllocation，协程帧从线程本地内存池中分配
+template <typename Executor> class TaskPromiseBase : public FrameAllocation {
+public:
+	// await 转换函数，用于等待其他协程任务
+	template <typename ResultType_, typename Executor_>
+	TaskAwaiter<ResultType_, Executor_>
+	await_transform(Task<ResultType_, Executor_>&& task) {
+		return TaskAwaiter<ResultType_, Executor_>(executor_, std::move(task));
+	}
+
+	// await 转换函数，用于解决延时调用问题
+	template <typename Rep_, typename Period_>
+	SleepAwaiter
+	await_transform(std::chrono::duration<Rep_, Period_>&& duration) {
+		// 向上取整到纳秒，不截断亚毫秒级延时
+		return SleepAwaiter(
+		    executor_, std::chrono::ceil<std::chrono::nanoseconds>(duration));
+	}
+
+	// await 转换函数，将当前协程的调度器绑定至 awaiter
+	// 按 awaiter 的实际类型匹配，派生的 awaiter 不会退化为基类
+	template <ExecutorBoundAwaiter Awaiter_>
+	Awaiter_ await_transform(Awaiter_&& awaiter) {
+		awaiter.executor_ = executor_;
+		return std::forward<Awaiter_>(awaiter);
+	}
+
+protected:
+	// 同类型调度器共享同一实例，参见 SharedExecutor
+	AbstractExecutor* executor_{SharedExecutor<Executor>::get()};
+};
+
 template <typename ResultType, typename Executor = NewThreadExecutor>
 class Task {
 
 public:
-	// promise 类型定义
-	class TaskPromise {
+	// promise 类型定义，调度器及 await 转换见 TaskPromiseBase
+	class TaskPromise : public TaskPromiseBase<Executor> {
 	public:
 		// 协程初始化及结束后操作内容
 		DispatchAwaiter initial_suspend() noexcept {
-			return DispatchAwaiter{&executor_};
+			return DispatchAwaiter{this->executor_};
 		}
 		
 		// 系统默认实现了 suspend_always 和 suspend_never 两个 awaiter
 		// 仅区别在 await_ready() 函数的返回值
-		// 这里 suspend_always 标识返回 false 情况，表示持续中断
-		// 可以使用 suspend_never 标识返回 true 情况，表示跳过中断                                                          
-		std::suspend_always final_suspend() noexcept { return {}; } /* NOLINT */
+		// 这里 FinalAwaiter 与 suspend_always 相同，保持协程挂起由 Task 负责销毁
+		// 同时通过对称转移恢复 co_await 等待该协程的调用方协程
+		FinalAwaiter<TaskPromise> final_suspend() noexcept { return {}; } /* NOLINT */
 
 		// 构造协程返回对象
 		Task<ResultType, Executor> get_return_object() {
@@ -48,102 +90,39 @@ public:
 			    std::coroutine_handle<TaskPromise>::from_promise(*this)};
 		}
 
-		// await 转换函数，用于对 await 传入参数进行处理
-		template <typename ResultType_, typename Executor_>
-		TaskAwaiter<ResultType_, Executor_>
-		await_transform(Task<ResultType_, Executor_>&& task) {
-			return TaskAwaiter<ResultType_, Executor_>(&executor_,
-			                                           std::move(task));
-		}
-
-		// await 转换函数，用于解决延时调用问题
-		template <typename Rep_, typename Period_>
-		SleepAwaiter
-		await_transform(std::chrono::duration<Rep_, Period_>&& duration) {
-			return SleepAwaiter(
-			    &executor_,
-			    std::chrono::duration_cast<std::chrono::milliseconds>(duration)
-			        .count());
-		}
-
-		// await 转换函数，用于处理读 channel
-		template <typename ValueType_>
-		auto await_transform(ReaderAwaiter<ValueType_> reader_awaiter) {
-			reader_awaiter.executor_ = &executor_;
-			return reader_awaiter;
-		}
-
-		// await 转换函数，用于处理写 channel
-		template <typename ValueType_>
-		auto await_transform(WriterAwaiter<ValueType_> writer_awaiter) {
-			writer_awaiter.executor_ = &executor_;
-			return writer_awaiter;
-		}
-
 		// co_return 调用返回值，对于 void 类型特例化为 return_void
 		void return_value(ResultType value) {
-			std::unique_lock<std::mutex> lock(completion_mutex_);
-			result_ = Result<ResultType>(std::move(value));
-			completion_.notify_all();
-			lock.unlock();
-
-			notify_callbacks();
+			completion_.set_result(Result<ResultType>(std::move(value)));
 		}
 
 		// 异常处理
 		void unhandled_exception() {
-			std::unique_lock<std::mutex> lock(completion_mutex_);
-			result_ = Result<ResultType>(std::current_exception());
-			completion_.notify_all();
-			lock.unlock();
-
-			notify_callbacks();
+			completion_.set_result(
+			    Result<ResultType>(std::current_exception()));
 		}
 
-		// 同步获取回调值
-		ResultType get_result() {
-			std::unique_lock<std::mutex> lock(completion_mutex_);
-
-			if (!result_.has_value())
-				completion_.wait(lock); // 当前线程阻塞同时释放锁
-
-			return result_->get_or_throw();
-		}
+		// 同步获取回调值，未完成时阻塞当前线程
+		ResultType get_result() { return completion_.get_result(); }
 
 		// 异步获取回调值
 		void on_completed(std::function<void(Result<ResultType>)>&& func) {
-			std::unique_lock<std::mutex> lock(completion_mutex_);
-
-			if (result_.has_value()) {
-				auto value = result_.value();
-				lock.unlock();
-				func(value);
-				return;
-			} else {
-				callbacks_.push_back(std::move(func));
-			}
+			completion_.on_completed(std::move(func));
 		}
 
-	private:
-		void notify_callbacks() {
-			std::unique_lock<std::mutex> lock(completion_mutex_);
-			auto value = result_.value();
-			auto callbacks = std::exchange(callbacks_, {});
-			lock.unlock();
-
-			for (auto& callback : callbacks) {
-				callback(value);
-			}
-		}
+		// 协程是否已经执行至 final_suspend
+		bool is_finished() const { return completion_.is_finished(); }
 
-	private:
-		std::optional<Result<ResultType>> result_{};
-		std::list<std::function<void(Result<ResultType>)>> callbacks_{};
+		// 记录 co_await 该协程的调用方协程，协程已经结束时返回 false
+		bool set_continuation(std::coroutine_handle<> continuation) {
+			return completion_.set_continuation(continuation);
+		}
 
-		Executor executor_{};
+		// 标记协程结束，返回需要恢复的调用方协程
+		std::coroutine_handle<> finish() { return completion_.finish(); }
 
-		std::mutex completion_mutex_{};
-		std::condition_variable completion_{};
+	private:
+		// 完成状态，包括结果、回调及调用方协程
+		TaskCompletion<ResultType> completion_{};
 	};
 
 public:
@@ -205,6 +184,7 @@ public:
 	}
 
 private:
+	template <typename Result_, typename Executor_> friend class TaskAwaiter;
 
 	// 协程句柄
 	// 可实现数据中转的功能，promise() 函数即可调用内部 prosie_type 对象
@@ -215,108 +195,40 @@ private:
 template <typename Executor> class Task<void, Executor> {
 public:
 	// promise 类型定义
-	class TaskPromise {
+	class TaskPromise : public TaskPromiseBase<Executor> {
 	public:
 		DispatchAwaiter initial_suspend() noexcept {
-			return DispatchAwaiter{&executor_};
-		}                                                           /* NOLINT */
-		std::suspend_always final_suspend() noexcept { return {}; } /* NOLINT */
+			return DispatchAwaiter{this->executor_};
+		}                                                                 /* NOLINT */
+		FinalAwaiter<TaskPromise> final_suspend() noexcept { return {}; } /* NOLINT */
 
 		Task<void, Executor> get_return_object() {
 			return Task{
 			    std::coroutine_handle<TaskPromise>::from_promise(*this)};
 		}
 
-		template <typename ResultType_, typename Executor_>
-		TaskAwaiter<ResultType_, Executor_>
-		await_transform(Task<ResultType_, Executor_>&& task) {
-			return TaskAwaiter<ResultType_, Executor_>{std::move(task)};
-		}
-
-		// await 转换函数，用于解决延时调用问题
-		template <typename Rep_, typename Period_>
-		SleepAwaiter
-		await_transform(std::chrono::duration<Rep_, Period_>&& duration) {
-			return SleepAwaiter(
-			    &executor_,
-			    std::chrono::duration_cast<std::chrono::milliseconds>(duration)
-			        .count());
-		}
-
-		// await 转换函数，用于处理读 channel
-		template <typename ValueType_>
-		auto await_transform(ReaderAwaiter<ValueType_> reader_awaiter) {
-			reader_awaiter.executor_ = &executor_;
-			return reader_awaiter;
-		}
-
-		// await 转换函数，用于处理写 channel
-		template <typename ValueType_>
-		auto await_transform(WriterAwaiter<ValueType_> writer_awaiter) {
-			writer_awaiter.executor_ = &executor_;
-			return writer_awaiter;
-		}
-
-		void return_void() {
-			std::unique_lock<std::mutex> lock(completion_mutex_);
-			result_ = Result<void>();
-			completion_.notify_all();
-			lock.unlock();
-
-			notify_callbacks();
-		}
+		void return_void() { completion_.set_result(Result<void>()); }
 
 		void unhandled_exception() {
-			std::unique_lock<std::mutex> lock(completion_mutex_);
-			result_ = Result<void>(std::current_exception());
-			completion_.notify_all();
-			lock.unlock();
-
-			notify_callbacks();
+			completion_.set_result(Result<void>(std::current_exception()));
 		}
 
-		void get_result() {
-			std::unique_lock<std::mutex> lock(completion_mutex_);
-
-			if (!result_.has_value())
-				completion_.wait(lock);
-
-			result_->get_or_throw();
-		}
+		void get_result() { completion_.get_result(); }
 
 		void on_completed(std::function<void(Result<void>)>&& func) {
-			std::unique_lock<std::mutex> lock(completion_mutex_);
-
-			if (result_.has_value()) {
-				auto value = result_.value();
-				lock.unlock();
-				func(value);
-				return;
-			} else {
-				callbacks_.push_back(std::move(func));
-			}
+			completion_.on_completed(std::move(func));
 		}
 
-	private:
-		void notify_callbacks() {
-			std::unique_lock<std::mutex> lock(completion_mutex_);
-			auto value = result_.value();
-			auto callbacks = std::exchange(callbacks_, {});
-			lock.unlock();
-
-			for (auto& callback : callbacks) {
-				callback(value);
-			}
-		}
+		bool is_finished() const { return completion_.is_finished(); }
 
-	private:
-		std::optional<Result<void>> result_{};
-		std::list<std::function<void(Result<void>)>> callbacks_{};
+		bool set_continuation(std::coroutine_handle<> continuation) {
+			return completion_.set_continuation(continuation);
+		}
 
-		Executor executor_{};
+		std::coroutine_handle<> finish() { return completion_.finish(); }
 
-		std::mutex completion_mutex_{};
-		std::condition_variable completion_{};
+	private:
+		TaskCompletion<void> completion_{};
 	};
 
 public:
@@ -373,6 +285,8 @@ public:
 	}
 
 private:
+	template <typename Result_, typename Executor_> friend class TaskAwaiter;
+
 	std::coroutine_handle<promise_type> handle_{};
 };
 
@@ -14,11 +14,11 @@ template <typename Result, typename Executor> class TaskAwaiter {
 public:
 	explicit TaskAwaiter(AbstractExecutor* executor,
 	                     Task<Result, Executor>&& task) noexcept
-	    : executor_(executor)
-	    , task_(std::move(task)) {}
+	    : task_(std::move(task))
+	    , executor_(executor) {}
 	TaskAwaiter(TaskAwaiter&& completion) noexcept
-	    : executor_(completion.executor_)
-	    , task_(std::exchange(completion.task_, {})) {}
+	    : task_(std::move(completion.task_))
+	    , executor_(completion.executor_) {}
 
 	TaskAwaiter(TaskAwaiter& value) = delete;
 	TaskAwaiter& operator=(TaskAwaiter&) = delete;
@@ -26,33 +26,53 @@ public:
 public:
 
 	// 判断当前协程是否已经完成
-	// true 表示协程已经完成，不再需要中断
+	// true 表示协程已经完成，不再需要中断，直接获取结果
 	// false 表示协程尚未完成，需要中断
-	constexpr bool await_ready() const noexcept { /* NOLINT */
-		return false;
+	bool await_ready() const noexcept { /* NOLINT */
+		return task_.handle_.promise().is_finished();
 	}
 
 	// handle 表示当前协程句柄
-	// 可以通过 handle.resume() 来唤醒当前协程，从而继续执行
 	// 此处 handle 即为 co_await 所在协程位置
-	// 这里也可以设置返回值 bool 来表示是否需要协程暂停
-	// 返回 false 不用暂停，true 则暂停，和上述 await_ready() 相反
-	void await_suspend(std::coroutine_handle<> handle) noexcept {
+	// 将 handle 作为 continuation 记录至被调用协程的 promise 中
+	// 被调用协程在 final_suspend 时通过对称转移直接恢复当前协程，不再嵌套调用栈
+	// 返回值为下一个要恢复的协程句柄，若被调用协程已经结束则直接恢复当前协程
+	std::coroutine_handle<>
+	await_suspend(std::coroutine_handle<> handle) noexcept {
 
-		// 为调用协程任务绑定回调，实现在该协程执行最后调用 handle.resume() 来唤醒当前协程
-		task_.finally([handle]() { handle.resume(); });
+		if (task_.handle_.promise().set_continuation(handle)) {
+			return std::noop_coroutine();
+		}
+
+		return handle;
 	}
 
 	// co_await 操作符的返回值，会在协程执行完成或者跳过的时候调用
-	// 这里即返回任务运算结果
-	// 这里会一直阻塞直到调用协程执行完成，然后返回结果
-	Result await_resume() noexcept { return task_.get_result(); }
+	// 这里即返回任务运算结果，被调用协程的异常在此处重新抛出
+	Result await_resume() { return task_.get_result(); }
 
 public:
-	Task<Result, Executor> task_{};
+	Task<Result, Executor> task_;
 	AbstractExecutor* executor_{};
 };
 
+// 协程结束时的 awaiter
+// 协程在 final_suspend 处挂起后，通过对称转移恢复等待该协程的调用方协程
+// 没有调用方等待时返回 noop_coroutine，直接返回至恢复该协程的位置
+template <typename Promise> class FinalAwaiter {
+
+public:
+	constexpr bool await_ready() const noexcept { return false; } /* NOLINT */
+
+	std::coroutine_handle<>
+	await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+		auto continuation = handle.promise().finish();
+		return continuation ? continuation : std::noop_coroutine();
+	}
+
+	void await_resume() noexcept {}
+};
+
 GOCOROUTINE_NAMESPACE_END
 
 #endif
@@ -0,0 +1,169 @@
+#ifndef GOCOROUTINE_TASK_COMPLETION_H
+#define GOCOROUTINE_TASK_COMPLETION_H
+
+#include "gocoroutine/result.h"
+#include "gocoroutine/utils.h"
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <utility>
+
+GOCOROUTINE_NAMESPACE_BEGIN
+
+// 协程任务完成状态，由 TaskPromise 持有
+// 使用一个原子状态字代替 mutex/condition_variable
+// 状态位：kContinuation 已记录调用方协程，kWaiter 存在阻塞等待线程，kCompleted 已完成，
+// kNotified 完成方已唤醒等待线程且此后不再访问该状态
+// 等待线程返回后即可能销毁 Task 并释放协程帧（或交由内存池复用），因此等待线程
+// 必须在 kNotified 之后才能返回，不能仅凭 kCompleted
+// 调用方协程使用单个内联 continuation 槽位，then/catching/finally
+// 回调使用无锁单链表记录，仅在注册回调时分配节点
+template <typename ResultType> class TaskCompletion {
+
+	struct CallbackNode {
+		std::function<void(Result<ResultType>)> func_{};
+		CallbackNode* next_{};
+	};
+
+	static constexpr uint32_t kContinuation = 1;
+	static constexpr uint32_t kWaiter = 2;
+	static constexpr uint32_t kCompleted = 4;
+	static constexpr uint32_t kNotified = 8;
+
+public:
+	TaskCompletion() = default;
+
+	~TaskCompletion() {
+		// 协程未完成即被销毁时，释放尚未执行的回调
+		auto node = callbacks_.load(std::memory_order_acquire);
+		while (node && node != closed()) {
+			delete std::exchange(node, node->next_);
+		}
+	}
+
+	TaskCompletion(const TaskCompletion&) = delete;
+	TaskCompletion& operator=(const TaskCompletion&) = delete;
+
+public:
+	// 记录协程结果，在 return_value/unhandled_exception 中调用
+	void set_result(Result<ResultType>&& result) { result_ = std::move(result); }
+
+	bool is_finished() const {
+		return state_.load(std::memory_order_acquire) & kCompleted;
+	}
+
+	// 记录 co_await 该协程的调用方协程，协程已经结束时返回 false
+	bool set_continuation(std::coroutine_handle<> continuation) {
+		continuation_ = continuation;
+		auto state =
+		    state_.fetch_or(kContinuation, std::memory_order_acq_rel);
+		return !(state & kCompleted);
+	}
+
+	// 标记协程结束，执行回调并唤醒阻塞等待线程，返回需要恢复的调用方协程
+	// 在 final_suspend 中调用，此时协程已经挂起
+	// 存在等待线程时，设置 kNotified 是对 this 的最后一次访问
+	std::coroutine_handle<> finish() {
+		notify_callbacks();
+
+		auto state = state_.fetch_or(kCompleted, std::memory_order_acq_rel);
+
+		// 存在调用方协程时其必然处于挂起状态，此时读取 continuation_ 是安全的
+		std::coroutine_handle<> continuation{};
+		if (state & kContinuation) {
+			continuation = continuation_;
+		}
+
+		// 仅在存在阻塞等待线程时才进行 futex 唤醒
+		if (state & kWaiter) {
+			state_.notify_all();
+			state_.fetch_or(kNotified, std::memory_order_release);
+		}
+
+		return continuation;
+	}
+
+	// 同步获取结果，未完成时通过 atomic::wait 阻塞
+	// 登记 kWaiter 时尚未完成，则完成方必然会唤醒并设置 kNotified，需等到该位才返回；
+	// kCompleted 至 kNotified 之间仅为一次 notify_all 调用，短暂让出即可
+	ResultType get_result() {
+		auto state = state_.load(std::memory_order_acquire);
+
+		if (!(state & kCompleted)) {
+			state = state_.fetch_or(kWaiter, std::memory_order_acq_rel);
+
+			if (!(state & kCompleted)) {
+				state |= kWaiter;
+				while (!(state & kNotified)) {
+					if (state & kCompleted) {
+						std::this_thread::yield();
+					} else {
+						state_.wait(state, std::memory_order_acquire);
+					}
+					state = state_.load(std::memory_order_acquire);
+				}
+			}
+		}
+
+		return result_.get_or_throw();
+	}
+
+	// 异步获取结果，已完成时直接在当前线程执行回调
+	void on_completed(std::function<void(Result<ResultType>)>&& func) {
+		auto node = new CallbackNode{std::move(func)};
+		auto head = callbacks_.load(std::memory_order_acquire);
+
+		do {
+			if (head == closed()) {
+				auto callback = std::move(node->func_);
+				delete node;
+				callback(result_);
+				return;
+			}
+
+			node->next_ = head;
+		} while (!callbacks_.compare_exchange_weak(
+		    head, node, std::memory_order_acq_rel, std::memory_order_acquire));
+	}
+
+private:
+	// 关闭回调链表并按注册顺序依次执行回调
+	// 在 noexcept 的 final_suspend 中执行，回调抛出的异常被忽略，不影响其余回调及协程结束
+	void notify_callbacks() {
+		auto head = callbacks_.exchange(closed(), std::memory_order_acq_rel);
+
+		CallbackNode* ordered = nullptr;
+		while (head) {
+			auto next = std::exchange(head->next_, ordered);
+			ordered = std::exchange(head, next);
+		}
+
+		while (ordered) {
+			auto node = std::exchange(ordered, ordered->next_);
+			try {
+				node->func_(result_);
+			} catch (...) {
+				// ignore
+			}
+			delete node;
+		}
+	}
+
+	// 回调链表关闭标记，完成后注册的回调直接执行
+	static CallbackNode* closed() {
+		static CallbackNode closed_node;
+		return &closed_node;
+	}
+
+private:
+	Result<ResultType> result_{};
+	std::coroutine_handle<> continuation_{};
+	std::atomic<CallbackNode*> callbacks_{};
+	std::atomic<uint32_t> state_{};
+};
+
+GOCOROUTINE_NAMESPACE_END
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef GOCOROUTINE_TICKER_H
+#define GOCOROUTINE_TICKER_H
+
+#include "gocoroutine/executor.h"
+#include "gocoroutine/scheduler.h"
+#include "gocoroutine/timing_wheel.h"
+#include "gocoroutine/utils.h"
+#include <chrono>
+#include <coroutine>
+#include <memory>
+#include <mutex>
+
+GOCOROUTINE_NAMESPACE_BEGIN
+
+// 周期触发器，参考 Go 中的 time.Ticker
+// 基于 Scheduler 的周期定时事件实现，整个生命周期只占用一个定时事件
+// 与 Go 相同，仅缓存一次未被接收的触发，协程处理过慢时多余的触发直接丢弃
+// 使用方式：while (true) { co_await ticker.tick(); ... }
+class Ticker {
+
+public:
+	using Clock = std::chrono::steady_clock;
+
+	class TickAwaiter;
+
+	template <typename Rep_, typename Period_>
+	explicit Ticker(std::chrono::duration<Rep_, Period_> period,
+	                PeriodicPolicy policy = PeriodicPolicy::kFixedRate,
+	                Scheduler& scheduler = Scheduler::shared())
+	    : state_(std::make_shared<State>()) {
+
+		// 定时回调持有共享状态，Ticker 析构与回调执行并发时状态依然有效
+		timer_ = scheduler.schedule_periodic(
+		    [state = state_]() { state->fire(); }, period, policy);
+	}
+
+	~Ticker() { stop(); }
+
+	Ticker(const Ticker&) = delete;
+	Ticker& operator=(const Ticker&) = delete;
+
+public:
+	// 等待下一次触发，返回触发时间
+	TickAwaiter tick();
+
+	// 停止触发，正在等待的协程不会被恢复
+	void stop() { timer_.cancel(); }
+
+private:
+	struct State {
+		std::mutex mutex_{};
+		bool ticked_{};                    // 是否缓存了一次未被接收的触发
+		Clock::time_point tick_time_{};    // 最近一次触发时间
+		std::coroutine_handle<> waiter_{}; // 正在等待的协程
+		AbstractExecutor* executor_{};
+
+		void fire() {
+			std::unique_lock<std::mutex> lock(mutex_);
+			tick_time_ = Clock::now();
+
+			if (!waiter_) {
+				ticked_ = true;
+				return;
+			}
+
+			auto handle = std::exchange(waiter_, {});
+			auto executor = std::exchange(executor_, {});
+			lock.unlock();
+
+			if (executor) {
+				executor->schedule(handle);
+			} else {
+				handle.resume();
+			}
+		}
+	};
+
+	std::shared_ptr<State> state_;
+	TimerHandle timer_{};
+};
+
+class Ticker::TickAwaiter {
+
+public:
+	explicit TickAwaiter(std::shared_ptr<State> state)
+	    : state_(std::move(state)) {}
+
+public:
+	constexpr bool await_ready() { return false; } /* NOLINT */
+
+	// 已有缓存的触发时直接恢复，否则登记等待
+	bool await_suspend(std::coroutine_handle<> handle) {
+		std::lock_guard<std::mutex> lock(state_->mutex_);
+
+		if (state_->ticked_) {
+			state_->ticked_ = false;
+			return false;
+		}
+
+		state_->waiter_ = handle;
+		state_->executor_ = executor_;
+		return true;
+	}
+
+	Clock::time_point await_resume() {
+		std::lock_guard<std::mutex> lock(state_->mutex_);
+		return state_->tick_time_;
+	}
+
+public:
+	AbstractExecutor* executor_{};
+
+private:
+	std::shared_ptr<State> state_;
+};
+
+inline Ticker::TickAwaiter Ticker::tick() { return TickAwaiter(state_); }
+
+GOCOROUTINE_NAMESPACE_END
+
+#endif
@@ -0,0 +1,462 @@
+#ifndef GOCOROUTINE_TIMING_WHEEL_H
+#define GOCOROUTINE_TIMING_WHEEL_H
+
+#include "gocoroutine/intrusive_list.h"
+#include "gocoroutine/utils.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+GOCOROUTINE_NAMESPACE_BEGIN
+
+class TimingWheel;
+
+// 周期定时事件的重新调度策略
+enum class PeriodicPolicy {
+	kFixedRate,  // 按上次到期时间加周期计算，错过的周期直接跳过，不累积漂移
+	kFixedDelay, // 按上次执行完毕时间加周期计算
+};
+
+// 此处设计为定时事件（即将任务与到期时间进行绑定）
+// 作为侵入式链表节点挂在时间轮槽位上，插入及删除均为 O(1)
+// 采用 operator() 重载，实现对于任务的调用
+class DelayedExecutable {
+
+public:
+	// 返回到期时间
+	int64_t get_scheduled_time() const { /* NOLINT */
+		return scheduler_time_;
+	}
+
+	// 返回按 slack 对齐后的实际到期时间
+	int64_t get_fire_time() const { /* NOLINT */
+		return fire_time_;
+	}
+
+	// 返回本次添加分配的 id，用于构造 TimerHandle
+	uint64_t get_id() const { /* NOLINT */
+		return id_;
+	}
+
+	// operator() 重载，实现对于定时任务的调用
+	void operator()() { func_(); }
+
+private:
+	friend class TimingWheel;
+	friend class IntrusiveList<DelayedExecutable>;
+
+	int64_t scheduler_time_{};     // 到期时间，单位由持有者决定
+	int64_t slack_{};              // 允许延后的时间，0 表示按精确时间到期
+	int64_t fire_time_{};          // 实际到期时间，按 slack 向上对齐后的到期时间
+	std::function<void()> func_{}; // 延时执行函数
+
+	int level_{}; // 所在时间轮层级及槽位，用于 O(1) 删除
+	int slot_{};
+
+	uint64_t id_{};  // 每次添加时分配，用于识别复用后的节点
+	bool pending_{}; // 是否仍位于时间轮中（未到期且未取消）
+
+	int64_t period_{}; // 周期，0 表示一次性定时事件
+	PeriodicPolicy policy_{};
+	bool cancelled_{}; // 周期事件执行期间被取消，执行完毕后不再重新调度
+
+	DelayedExecutable* prev_{};
+	DelayedExecutable* next_{};
+	IntrusiveList<DelayedExecutable>* list_{};
+};
+
+// 分层时间轮
+// 共 kLevelCount 层，每层 kSlotCount 个槽位，第 k 层每个槽位覆盖 kSlotCount^k 个 tick
+// 定时事件按剩余 tick 数放入对应层级，低层槽位到期时批量取出，高层槽位在对应边界处
+// 向下层重新分配（cascade）。使用位图记录非空槽位，可 O(1) 计算下一个需要处理的 tick
+// 定时事件保存精确的到期时间，每个 tick 覆盖 tick_duration 个时间单位，同一 tick
+// 内的事件按精确时间到期，时间轮仅用于分桶，不会将到期时间截断到 tick 精度
+// 非线程安全，由 Scheduler 等持有者加锁保护
+class TimingWheel {
+
+public:
+	static constexpr int kLevelCount = 6;
+	static constexpr int kSlotBits = 6;
+	static constexpr int64_t kSlotCount = int64_t(1) << kSlotBits;
+	static constexpr int64_t kSlotMask = kSlotCount - 1;
+
+	// 时间轮可表示的最大 tick 差值，超出部分在到期时重新插入
+	static constexpr int64_t kMaxDelta =
+	    (int64_t(1) << (kSlotBits * kLevelCount)) - 1;
+
+public:
+	explicit TimingWheel(int64_t current_time = 0, int64_t tick_duration = 1)
+	    : tick_duration_(tick_duration)
+	    , current_tick_(current_time / tick_duration) {}
+
+	~TimingWheel() {
+		for (auto& level : slots_) {
+			for (auto& slot : level) {
+				while (auto node = slot.pop_front()) {
+					delete node;
+				}
+			}
+		}
+
+		while (auto node = free_list_.pop_front()) {
+			delete node;
+		}
+	}
+
+	TimingWheel(const TimingWheel&) = delete;
+	TimingWheel& operator=(const TimingWheel&) = delete;
+
+public:
+	bool empty() const { return size_ == 0; }
+	std::size_t size() const { return size_; }
+
+	// 当前 tick，小于该值的定时事件均已取出
+	int64_t current_tick() const { return current_tick_; }
+	int64_t tick_duration() const { return tick_duration_; }
+
+	// 添加定时事件，已过期的事件在下一次 advance 时取出
+	// slack 不为 0 时到期时间向上对齐到 slack 的整数倍，落在同一区间内的定时事件
+	// 在同一时刻到期，合并为一次唤醒，最多延后 slack
+	DelayedExecutable* add(std::function<void()>&& func, int64_t expire_time,
+	                       int64_t slack = 0) {
+		auto node = free_list_.pop_front();
+		if (!node) {
+			node = new DelayedExecutable();
+		}
+
+		node->func_ = std::move(func);
+		node->slack_ = slack;
+		set_expire_time(node, expire_time);
+		node->id_ = ++next_id_;
+		node->pending_ = true;
+
+		insert(node);
+		++size_;
+		return node;
+	}
+
+	// 添加周期定时事件，首次在 expire_time 到期，此后由 complete 复用同一节点重新调度
+	DelayedExecutable* add_periodic(std::function<void()>&& func,
+	                                int64_t expire_time, int64_t period,
+	                                PeriodicPolicy policy, int64_t slack = 0) {
+		auto node = add(std::move(func), expire_time, slack);
+		node->period_ = period;
+		node->policy_ = policy;
+		return node;
+	}
+
+	// 回收 advance 取出并执行完毕的定时事件
+	// 节点在时间轮析构前不会释放，以保证 TimerHandle 持有的节点指针始终可以校验
+	void release(DelayedExecutable* node) {
+		node->func_ = nullptr;
+		node->period_ = 0;
+		node->slack_ = 0;
+		node->cancelled_ = false;
+		free_list_.push_back(node);
+	}
+
+	void release(IntrusiveList<DelayedExecutable>& nodes) {
+		while (auto node = nodes.pop_front()) {
+			release(node);
+		}
+	}
+
+	// 处理执行完毕的定时事件，now 为执行完毕的时间
+	// 周期事件按策略计算下次到期时间并重新插入，不重新分配节点，其余事件回收
+	void complete(IntrusiveList<DelayedExecutable>& nodes, int64_t now,
+	              bool rearm = true) {
+		while (auto node = nodes.pop_front()) {
+			if (!rearm || node->period_ == 0 || node->cancelled_) {
+				release(node);
+				continue;
+			}
+
+			int64_t expire = node->scheduler_time_ + node->period_;
+			if (node->policy_ == PeriodicPolicy::kFixedDelay) {
+				expire = now + node->period_;
+			} else if (expire <= now) {
+				expire += ((now - expire) / node->period_ + 1) * node->period_;
+			}
+
+			set_expire_time(node, expire);
+			node->pending_ = true;
+			insert(node);
+			++size_;
+		}
+	}
+
+	// 取消时间轮中所有周期事件，一次性事件不受影响
+	void cancel_periodic() {
+		for (int level = 0; level < kLevelCount; ++level) {
+			for (int slot = 0; slot < kSlotCount; ++slot) {
+				auto node = slots_[level][slot].front();
+				while (node) {
+					auto next = node->next_;
+					if (node->period_ > 0) {
+						cancel(node, node->id_);
+					}
+					node = next;
+				}
+			}
+		}
+	}
+
+	// 取消尚未到期的定时事件，O(1) 移出时间轮并回收，不再执行
+	// id 与节点当前分配的 id 不一致说明节点已被复用，返回是否取消成功
+	// 周期事件正在执行时仅做标记，执行完毕后由 complete 回收
+	bool cancel(DelayedExecutable* node, uint64_t id) {
+		if (node->id_ != id)
+			return false;
+
+		if (!node->pending_) {
+			if (node->period_ == 0 || node->cancelled_)
+				return false;
+
+			node->cancelled_ = true;
+			return true;
+		}
+
+		auto& slot = slots_[node->level_][node->slot_];
+		slot.remove(node);
+		if (slot.empty()) {
+			bitmaps_[node->level_] &= ~(uint64_t(1) << node->slot_);
+		}
+
+		node->pending_ = false;
+		--size_;
+		release(node);
+		return true;
+	}
+
+	// 取出所有到期时间不大于 now 的定时事件，放入 expired 链表
+	// 早于当前 tick 的槽位整体取出，跳过没有定时事件的 tick，仅处理非空槽位及需要
+	// cascade 的边界；now 所在 tick 的槽位按精确到期时间取出
+	void advance(int64_t now, IntrusiveList<DelayedExecutable>& expired) {
+		int64_t tick = now / tick_duration_;
+
+		while (current_tick_ < tick) {
+			auto next = next_tick();
+
+			if (next < 0 || next >= tick) {
+				current_tick_ = tick;
+				break;
+			}
+
+			current_tick_ = next;
+			cascade(next);
+			expire_slot(next, next * tick_duration_ + tick_duration_ - 1,
+			            expired);
+			current_tick_ = next + 1;
+		}
+
+		if (current_tick_ == tick) {
+			cascade(tick);
+			expire_slot(tick, now, expired);
+		}
+	}
+
+	// 下一个需要处理的时间（定时事件到期或需要 cascade），无定时事件时返回 -1
+	// 第 0 层最近的非空槽位按其中最早的到期时间计算，不受 tick 精度限制
+	int64_t next_time() const {
+		if (size_ == 0)
+			return -1;
+
+		int64_t next = -1;
+		for (int level = 1; level < kLevelCount; ++level) {
+			if (!bitmaps_[level])
+				continue;
+
+			int64_t time = level_next_tick(level) * tick_duration_;
+			if (next < 0 || time < next) {
+				next = time;
+			}
+		}
+
+		if (bitmaps_[0]) {
+			int64_t tick = level_next_tick(0);
+			auto& slot = slots_[0][tick & kSlotMask];
+
+			// 被截断的定时事件到期时间晚于槽位，最迟在槽位结束时处理
+			int64_t time = tick * tick_duration_ + tick_duration_ - 1;
+			for (auto node = slot.front(); node; node = node->next_) {
+				time = std::min(time, node->fire_time_);
+			}
+
+			if (next < 0 || time < next) {
+				next = time;
+			}
+		}
+
+		return next;
+	}
+
+private:
+	static int64_t round_up(int64_t tick, int shift) {
+		int64_t mask = (int64_t(1) << shift) - 1;
+		return (tick + mask) & ~mask;
+	}
+
+	// 指定层级下一个非空槽位对应的 tick，高层为 cascade 边界
+	int64_t level_next_tick(int level) const {
+		int shift = kSlotBits * level;
+		int64_t base =
+		    level == 0 ? current_tick_ : round_up(current_tick_, shift);
+		int64_t distance =
+		    next_slot_distance(level, (base >> shift) & kSlotMask);
+		return base + (distance << shift);
+	}
+
+	// 下一个需要处理的 tick（槽位到期或需要 cascade），无定时事件时返回 -1
+	int64_t next_tick() const {
+		int64_t next = -1;
+		for (int level = 0; level < kLevelCount; ++level) {
+			if (!bitmaps_[level])
+				continue;
+
+			int64_t tick = level_next_tick(level);
+			if (next < 0 || tick < next) {
+				next = tick;
+			}
+		}
+
+		return next;
+	}
+
+	// 从 index 开始（含）到下一个非空槽位的距离，按环形计算
+	int64_t next_slot_distance(int level, int64_t index) const {
+		uint64_t bitmap = bitmaps_[level];
+		uint64_t rotated = index == 0 ? bitmap
+		                              : (bitmap >> index) |
+		                                    (bitmap << (kSlotCount - index));
+		return __builtin_ctzll(rotated);
+	}
+
+	// 周期事件按精确到期时间计算下次到期，仅实际到期时间受 slack 影响，不累积漂移
+	static void set_expire_time(DelayedExecutable* node, int64_t expire_time) {
+		node->scheduler_time_ = expire_time;
+		node->fire_time_ = expire_time;
+
+		if (node->slack_ > 0 && expire_time > 0) {
+			node->fire_time_ =
+			    (expire_time + node->slack_ - 1) / node->slack_ * node->slack_;
+		}
+	}
+
+	// 按剩余 tick 数选择层级及槽位
+	void insert(DelayedExecutable* node) {
+		int64_t expire =
+		    std::max(node->fire_time_ / tick_duration_, current_tick_);
+		int64_t delta = std::min(expire - current_tick_, kMaxDelta);
+		expire = current_tick_ + delta;
+
+		int level = 0;
+		while (level + 1 < kLevelCount &&
+		       delta >= (int64_t(1) << (kSlotBits * (level + 1)))) {
+			++level;
+		}
+
+		int slot = (expire >> (kSlotBits * level)) & kSlotMask;
+		node->level_ = level;
+		node->slot_ = slot;
+
+		slots_[level][slot].push_back(node);
+		bitmaps_[level] |= uint64_t(1) << slot;
+	}
+
+	IntrusiveList<DelayedExecutable> take_slot(int level, int slot) {
+		bitmaps_[level] &= ~(uint64_t(1) << slot);
+		return std::move(slots_[level][slot]);
+	}
+
+	// 将到达边界的高层槽位向下分配，每个 tick 仅处理一次
+	void cascade(int64_t tick) {
+		if (cascaded_tick_ == tick)
+			return;
+		cascaded_tick_ = tick;
+
+		for (int level = kLevelCount - 1; level > 0; --level) {
+			int shift = kSlotBits * level;
+			if (tick & ((int64_t(1) << shift) - 1))
+				continue;
+
+			auto slot = take_slot(level, (tick >> shift) & kSlotMask);
+			while (auto node = slot.pop_front()) {
+				insert(node);
+			}
+		}
+	}
+
+	// 取出第 0 层 tick 对应槽位中到期时间不大于 now 的定时事件
+	void expire_slot(int64_t tick, int64_t now,
+	                 IntrusiveList<DelayedExecutable>& expired) {
+		auto slot = take_slot(0, tick & kSlotMask);
+		while (auto node = slot.pop_front()) {
+
+			// 尚未到期（同一 tick 内稍晚，或超出最大 tick 差值而被截断）的定时事件，
+			// 重新插入
+			if (node->fire_time_ > now) {
+				insert(node);
+				continue;
+			}
+
+			node->pending_ = false;
+			expired.push_back(node);
+			--size_;
+		}
+	}
+
+private:
+	IntrusiveList<DelayedExecutable> slots_[kLevelCount][kSlotCount]{};
+	uint64_t bitmaps_[kLevelCount]{};
+
+	int64_t tick_duration_{1};
+	int64_t current_tick_{};
+	int64_t cascaded_tick_{-1};
+	uint64_t next_id_{};
+	std::size_t size_{};
+
+	IntrusiveList<DelayedExecutable> free_list_{};
+};
+
+// 定时事件句柄，由持有时间轮及其互斥锁的调度器返回
+// 仅保存指针及 id，可拷贝，取消操作加锁后 O(1) 完成
+// 不能晚于创建它的调度器使用
+class TimerHandle {
+
+public:
+	TimerHandle() = default;
+
+	TimerHandle(std::mutex* mutex, TimingWheel* timing_wheel,
+	            DelayedExecutable* node, uint64_t id)
+	    : mutex_(mutex)
+	    , timing_wheel_(timing_wheel)
+	    , node_(node)
+	    , id_(id) {}
+
+public:
+	bool valid() const { return node_ != nullptr; }
+
+	// 取消定时事件，已到期、已执行或已取消时返回 false
+	bool cancel() {
+		if (!node_)
+			return false;
+
+		std::lock_guard<std::mutex> lock(*mutex_);
+		auto cancelled = timing_wheel_->cancel(node_, id_);
+		node_ = nullptr;
+		return cancelled;
+	}
+
+private:
+	std::mutex* mutex_{};
+	TimingWheel* timing_wheel_{};
+	DelayedExecutable* node_{};
+	uint64_t id_{};
+};
+
+GOCOROUTINE_NAMESPACE_END
+
+#endif
@@ -91,6 +91,15 @@ GOCOROUTINE_NAMESPACE_BEGIN
 
 #endif
 
+// 自旋等待时的 CPU 提示指令
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define CPU_RELAX() asm volatile("yield" ::: "memory")
+#else
+#define CPU_RELAX() ;
+#endif
+
 #define likely(x) __builtin_expect(!!(x), 1) 
 #define unlikely(x) __builtin_expect(!!(x), 0)
 
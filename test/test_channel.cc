@@ -1,6 +1,16 @@
+#include "gocoroutine/broadcast_channel.h"
 #include "gocoroutine/channel.h"
+#include "gocoroutine/executor.h"
 #include "gocoroutine/task.h"
 #include "gocoroutine/utils.h"
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest/doctest.h"
@@ -22,30 +32,25 @@ Task<void, LooperExecutor> Producer(Channel<int> &channel) {
 }
 
 Task<void, LooperExecutor> Consumer(Channel<int> &channel) {
-  while (channel.is_active()) {
-    try {
-      // 或者使用 read 函数：auto received = co_await channel.read();
-      int received;
-      co_await (channel >> received);
-      DEBUGFMTLOG("receive: {}", received);
-      co_await 2s;
-    } catch (std::exception &e) {
-      DEBUGFMTLOG("exception: {}", e.what());
+  // 关闭且读完后结束，不通过异常判断
+  while (true) {
+    auto received = co_await channel.read_result();
+    if (!received) {
+      break;
     }
+
+    DEBUGFMTLOG("receive: {}", received.value());
+    co_await 2s;
   }
 
   DEBUGFMTLOG("exit.");
 }
 
 Task<void, LooperExecutor> Consumer2(Channel<int> &channel) {
-  while (channel.is_active()) {
-    try {
-      auto received = co_await channel.read();
-      DEBUGFMTLOG("receive2: {}", received);
-      co_await 3s;
-    } catch (std::exception &e) {
-      DEBUGFMTLOG("exception2: {}", e.what());
-    }
+  // 或者使用 read_optional 函数
+  while (auto received = co_await channel.read_optional()) {
+    DEBUGFMTLOG("receive2: {}", *received);
+    co_await 3s;
   }
 
   DEBUGFMTLOG("exit.");
@@ -72,4 +77,854 @@ TEST_CASE("channel") {
   consumer.get_result();
   consumer2.get_result();
 
-}
\ No newline at end of file
+}
+template <typename Channel_>
+Task<void, ThreadPoolExecutor> pool_producer(Channel_ &channel, int count) {
+  for (int i = 1; i <= count; ++i) {
+    co_await channel.write(i);
+  }
+}
+
+template <typename Channel_>
+Task<long long, ThreadPoolExecutor> pool_consumer(Channel_ &channel, int count) {
+  long long sum = 0;
+  for (int i = 0; i < count; ++i) {
+    sum += co_await channel.read();
+  }
+  co_return sum;
+}
+
+TEST_CASE("buffered channel") {
+  constexpr int kCount = 20000;
+  auto pool = ThreadPoolExecutor(4);
+  SharedExecutor<ThreadPoolExecutor>::set(&pool);
+
+  // 多生产者多消费者，缓冲区满/空时挂起，无锁路径与挂起路径交替出现
+  {
+    auto channel = Channel<int>(8);
+    std::vector<Task<void, ThreadPoolExecutor>> producers;
+    std::vector<Task<long long, ThreadPoolExecutor>> consumers;
+    for (int i = 0; i < 4; ++i) {
+      producers.emplace_back(pool_producer(channel, kCount));
+      consumers.emplace_back(pool_consumer(channel, kCount));
+    }
+
+    long long sum = 0;
+    for (auto &consumer : consumers) {
+      sum += consumer.get_result();
+    }
+    for (auto &producer : producers) {
+      producer.get_result();
+    }
+    CHECK(sum == 4LL * kCount * (kCount + 1) / 2);
+  }
+
+  // 单生产者单消费者
+  {
+    auto channel = SpscChannel<int>(8);
+    auto producer = pool_producer(channel, kCount);
+    auto consumer = pool_consumer(channel, kCount);
+    CHECK(consumer.get_result() == 1LL * kCount * (kCount + 1) / 2);
+    producer.get_result();
+  }
+
+  pool.shutdown();
+  pool.join();
+  SharedExecutor<ThreadPoolExecutor>::set(nullptr);
+}
+
+Task<int, NoopExecuter> parked_reader(Channel<int> &channel) {
+  co_return co_await channel.read();
+}
+
+TEST_CASE("parked readers") {
+  constexpr int kReaderCount = 10000;
+  auto channel = Channel<int>();
+
+  // NoopExecuter 下协程同步执行至 read 处挂起
+  std::vector<Task<int, NoopExecuter>> readers;
+  std::vector<Task<int, NoopExecuter>> cancelled;
+  for (int i = 0; i < kReaderCount; ++i) {
+    (i % 2 ? readers : cancelled).emplace_back(parked_reader(channel));
+  }
+
+  // 销毁一半挂起的协程，awaiter 析构时 O(1) 移出等待链表
+  cancelled.clear();
+
+  // 关闭后剩余协程全部被唤醒并收到异常
+  channel.close();
+  int closed = 0;
+  for (auto &reader : readers) {
+    try {
+      reader.get_result();
+    } catch (std::exception &e) {
+      ++closed;
+    }
+  }
+  CHECK(closed == kReaderCount / 2);
+}
+
+// 节点只属于其所在的链表，remove_reader 等据此判断，位于其他链表中时不会误删
+struct ListNode {
+  ListNode *prev_{};
+  ListNode *next_{};
+  IntrusiveList<ListNode> *list_{};
+};
+
+TEST_CASE("intrusive list membership") {
+  ListNode first, second;
+  IntrusiveList<ListNode> parked, staged;
+  parked.push_back(&first);
+  staged.push_back(&second);
+  CHECK(parked.contains(&first));
+  CHECK_FALSE(parked.contains(&second));
+  CHECK_FALSE(staged.contains(&first));
+
+  // 移动及拼接后归属随之转移
+  staged.splice_back(parked);
+  CHECK(staged.contains(&first));
+  CHECK_FALSE(parked.contains(&first));
+
+  auto moved = std::move(staged);
+  CHECK(moved.contains(&first));
+  CHECK(moved.contains(&second));
+  CHECK(moved.pop_front() == &second);
+  CHECK_FALSE(moved.contains(&second));
+  CHECK(moved.size() == 1);
+}
+
+TEST_CASE("try read write") {
+  // 有缓冲时不挂起地读写缓冲区
+  auto channel = Channel<int>(2);
+  CHECK_FALSE(channel.try_read().has_value());
+  CHECK(channel.try_write(1));
+  CHECK(channel.try_write(2));
+  CHECK_FALSE(channel.try_write(3));
+  CHECK(channel.try_read() == 1);
+  CHECK(parked_reader(channel).get_result() == 2);
+
+  // 无缓冲时仅与已挂起的读方交接，写入失败时值保持不变
+  auto unbuffered = Channel<std::unique_ptr<int>>();
+  auto value = std::make_unique<int>(42);
+  CHECK_FALSE(unbuffered.try_write(std::move(value)));
+  CHECK(value != nullptr);
+
+  auto reader = [](Channel<std::unique_ptr<int>> &channel) -> Task<int, NoopExecuter> {
+    co_return *co_await channel.read();
+  }(unbuffered);
+  CHECK(unbuffered.try_write(std::move(value)));
+  CHECK(reader.get_result() == 42);
+
+  channel.close();
+  CHECK_THROWS(channel.try_read());
+
+  // 容量不是 2 的幂时缓冲的元素个数仍与声明的容量一致
+  auto single = Channel<int>(1);
+  CHECK(single.try_write(1));
+  CHECK_FALSE(single.try_write(2));
+
+  auto triple = SpscChannel<int>(3);
+  for (int i = 0; i < 3; ++i) {
+    CHECK(triple.try_write(i));
+  }
+  CHECK_FALSE(triple.try_write(3));
+  CHECK(triple.try_read() == 0);
+  CHECK(triple.try_write(3));
+  CHECK_FALSE(triple.try_write(4));
+}
+
+Task<void, ThreadPoolExecutor> batch_producer(Channel<int> &channel, int count) {
+  std::vector<int> values;
+  for (int i = 1; i <= count; ++i) {
+    values.push_back(i);
+  }
+
+  auto pending = std::span<int>(values);
+  while (!pending.empty()) {
+    pending = pending.subspan(co_await channel.write_batch(pending));
+  }
+}
+
+Task<long long, ThreadPoolExecutor> batch_consumer(Channel<int> &channel, int count) {
+  long long sum = 0;
+  while (count > 0) {
+    auto values = co_await channel.read_batch(64);
+    for (auto value : values) {
+      sum += value;
+    }
+    count -= int(values.size());
+  }
+  co_return sum;
+}
+
+TEST_CASE("batch read write") {
+  constexpr int kCount = 20000;
+  auto pool = ThreadPoolExecutor(4);
+  SharedExecutor<ThreadPoolExecutor>::set(&pool);
+
+  // 批量读写与逐个读写混合，有缓冲及无缓冲 channel 结果一致
+  for (int capacity : {0, 16}) {
+    auto channel = Channel<int>(capacity);
+    auto producer = batch_producer(channel, kCount);
+    auto single_producer = pool_producer(channel, kCount);
+    auto consumer = batch_consumer(channel, 2 * kCount);
+    CHECK(consumer.get_result() == 2LL * kCount * (kCount + 1) / 2);
+    producer.get_result();
+    single_producer.get_result();
+  }
+
+  pool.shutdown();
+  pool.join();
+  SharedExecutor<ThreadPoolExecutor>::set(nullptr);
+}
+
+// 手动驱动的执行器，调度的任务在 run_all 时才执行，用于确定性地安排协程恢复时机
+class ManualExecutor : public AbstractExecutor {
+public:
+  void execute(std::function<void()> &&func) override {
+    queue_.push_back(std::move(func));
+  }
+
+  void run_all() {
+    while (!queue_.empty()) {
+      auto func = std::move(queue_.front());
+      queue_.pop_front();
+      func();
+    }
+  }
+
+private:
+  std::deque<std::function<void()>> queue_;
+};
+
+TEST_CASE("batch write after close") {
+  auto &executor =
+      *static_cast<ManualExecutor *>(SharedExecutor<ManualExecutor>::get());
+  auto channel = Channel<int>(2);
+  CHECK(channel.try_write(0));
+  CHECK(channel.try_write(0));
+
+  // 缓冲区已满，以第一个元素挂起
+  std::vector<int> values({1, 2, 3});
+  auto writer = [](Channel<int> &channel, std::span<int> values) -> Task<std::size_t, ManualExecutor> {
+    co_return co_await channel.write_batch(values);
+  }(channel, values);
+  executor.run_all();
+
+  // 第一个元素写入后写方待恢复，此时关闭，恢复后不再补充写入
+  CHECK(channel.try_read() == 0);
+  CHECK(channel.try_read() == 0);
+  channel.close();
+  executor.run_all();
+
+  CHECK(writer.get_result() == 1);
+  CHECK(channel.try_read() == 1);
+  CHECK_THROWS(channel.try_read());
+}
+
+Task<std::vector<int>, NoopExecuter> drain_reader(Channel<int> &channel) {
+  std::vector<int> received;
+  while (auto value = co_await channel.read_optional()) {
+    received.push_back(*value);
+  }
+  co_return received;
+}
+
+TEST_CASE("close drains buffer") {
+  // 关闭前写入的数据仍可读取，读完后 read_optional 返回空值、read 抛出异常
+  auto channel = Channel<int>(4);
+  CHECK(channel.try_write(1));
+  CHECK(channel.try_write(2));
+  channel.close();
+  CHECK_THROWS(channel.try_write(3));
+
+  auto drained = drain_reader(channel).get_result();
+  CHECK(drained == std::vector<int>({1, 2}));
+  CHECK_THROWS(parked_reader(channel).get_result());
+
+  // 挂起的读方被关闭唤醒时结束读取
+  auto empty = Channel<int>(4);
+  auto reader = drain_reader(empty);
+  CHECK(empty.try_write(5));
+  empty.close();
+  CHECK(reader.get_result() == std::vector<int>(1, 5));
+}
+
+// 读取发现缓冲区为空时调用一次 on_empty，用于在读方两次检查之间确定性地插入写入及关闭
+struct HookedBuffer : MpmcRingBuffer<int> {
+  static inline std::function<void()> on_empty;
+
+  using MpmcRingBuffer<int>::MpmcRingBuffer;
+
+  std::optional<int> try_pop() {
+    if (auto value = MpmcRingBuffer<int>::try_pop())
+      return value;
+
+    if (auto hook = std::exchange(on_empty, nullptr))
+      hook();
+    return std::nullopt;
+  }
+};
+
+TEST_CASE("close race drains buffer") {
+  // 读方看到缓冲区为空后、检查关闭前，写方写入并关闭，数据不能丢失
+  using HookedChannel = Channel<int, HookedBuffer>;
+  auto channel = HookedChannel(4);
+  HookedBuffer::on_empty = [&] {
+    CHECK(channel.try_write(1));
+    channel.close();
+  };
+
+  auto batch = [](HookedChannel &channel) -> Task<std::vector<int>, NoopExecuter> {
+    co_return co_await channel.read_batch(4);
+  }(channel).get_result();
+  CHECK(batch == std::vector<int>(1, 1));
+}
+
+TEST_CASE("read result") {
+  auto channel = Channel<int>(2);
+  auto writer = [](Channel<int> &channel, int value) -> Task<ChannelStatus, NoopExecuter> {
+    co_return co_await channel.write_result(value);
+  };
+  auto reader = [](Channel<int> &channel) -> Task<ChannelResult<int>, NoopExecuter> {
+    co_return co_await channel.read_result();
+  };
+
+  CHECK(writer(channel, 7).get_result() == ChannelStatus::kOk);
+  channel.close();
+  CHECK(writer(channel, 8).get_result() == ChannelStatus::kClosed);
+
+  auto first = reader(channel).get_result();
+  CHECK(first.ok());
+  CHECK(first.value() == 7);
+  CHECK(reader(channel).get_result().status() == ChannelStatus::kClosed);
+}
+
+Task<std::vector<int>, NoopExecuter> range_reader(Channel<int> &channel,
+                                                   std::size_t batch_size) {
+  std::vector<int> received;
+  auto range = channel.range(batch_size);
+  while (co_await range.next()) {
+    received.push_back(range.value());
+  }
+  co_return received;
+}
+
+Task<long long, ThreadPoolExecutor> range_consumer(Channel<int> &channel) {
+  long long sum = 0;
+  auto range = channel.range();
+  while (co_await range.next()) {
+    sum += range.value();
+  }
+  co_return sum;
+}
+
+TEST_CASE("channel range") {
+  // 按批次拉取，顺序与逐个读取一致，关闭且读完后结束
+  auto channel = Channel<int>(8);
+  for (int i = 0; i < 7; ++i) {
+    CHECK(channel.try_write(i));
+  }
+  channel.close();
+  auto drained = range_reader(channel, 3).get_result();
+  CHECK(drained == std::vector<int>({0, 1, 2, 3, 4, 5, 6}));
+
+  // 拉取批次时发现缓冲区为空，随后写入 N 个值并关闭，N 个值均被迭代
+  auto hooked = Channel<int, HookedBuffer>(8);
+  HookedBuffer::on_empty = [&] {
+    for (int i = 0; i < 5; ++i) {
+      CHECK(hooked.try_write(i));
+    }
+    hooked.close();
+  };
+  auto raced = [](Channel<int, HookedBuffer> &channel) -> Task<std::vector<int>, NoopExecuter> {
+    std::vector<int> received;
+    auto range = channel.range(2);
+    while (co_await range.next()) {
+      received.push_back(range.value());
+    }
+    co_return received;
+  }(hooked).get_result();
+  CHECK(raced == std::vector<int>({0, 1, 2, 3, 4}));
+
+  constexpr int kCount = 20000;
+  auto pool = ThreadPoolExecutor(4);
+  SharedExecutor<ThreadPoolExecutor>::set(&pool);
+
+  for (int capacity : {0, 16}) {
+    auto channel = Channel<int>(capacity);
+    auto consumer = range_consumer(channel);
+    auto producer = pool_producer(channel, kCount);
+    producer.get_result();
+    channel.close();
+    CHECK(consumer.get_result() == 1LL * kCount * (kCount + 1) / 2);
+  }
+
+  pool.shutdown();
+  pool.join();
+  SharedExecutor<ThreadPoolExecutor>::set(nullptr);
+}
+
+TEST_CASE("unbounded channel") {
+  constexpr int kCount = 10000;
+
+  // 没有读方时写入也不挂起，统计突发峰值
+  auto channel = UnboundedChannel<int>(16);
+  for (int i = 0; i < kCount; ++i) {
+    CHECK(channel.try_write(i));
+  }
+  CHECK(channel.buffer()->high_water_mark() == kCount);
+
+  long long sum = 0;
+  while (auto value = channel.try_read()) {
+    sum += *value;
+  }
+  CHECK(sum == 1LL * kCount * (kCount - 1) / 2);
+
+  // 不超过峰值的突发复用空闲分段，不再分配
+  auto segments = channel.buffer()->segment_count();
+  for (int i = 0; i < kCount / 2; ++i) {
+    CHECK(channel.try_write(i));
+  }
+  CHECK(channel.buffer()->segment_count() == segments);
+
+  // 多生产者多消费者
+  auto pool = ThreadPoolExecutor(4);
+  SharedExecutor<ThreadPoolExecutor>::set(&pool);
+  {
+    auto unbounded = UnboundedChannel<int>();
+    std::vector<Task<void, ThreadPoolExecutor>> producers;
+    std::vector<Task<long long, ThreadPoolExecutor>> consumers;
+    for (int i = 0; i < 4; ++i) {
+      producers.emplace_back(pool_producer(unbounded, kCount));
+      consumers.emplace_back(pool_consumer(unbounded, kCount));
+    }
+
+    long long total = 0;
+    for (auto &consumer : consumers) {
+      total += consumer.get_result();
+    }
+    for (auto &producer : producers) {
+      producer.get_result();
+    }
+    CHECK(total == 4LL * kCount * (kCount + 1) / 2);
+  }
+
+  pool.shutdown();
+  pool.join();
+  SharedExecutor<ThreadPoolExecutor>::set(nullptr);
+}
+
+TEST_CASE("segmented buffer size") {
+  constexpr int kCount = 100000;
+
+  // 生产者与消费者并发时，size() 不能下溢，也不能超过峰值
+  auto buffer = SegmentedBuffer<int>(16);
+  std::atomic<bool> done{false};
+  std::atomic<int> consumed{0};
+  std::atomic<bool> in_range{true};
+
+  auto check_size = [&] {
+    auto size = buffer.size();
+    if (size > buffer.high_water_mark() || size > 2 * kCount) {
+      in_range.store(false);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 2; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < kCount; ++j) {
+        buffer.try_push(j);
+      }
+    });
+    threads.emplace_back([&] {
+      while (consumed.load() < 2 * kCount) {
+        if (buffer.try_pop()) {
+          consumed.fetch_add(1);
+          check_size();
+        }
+      }
+    });
+  }
+
+  std::thread checker([&] {
+    while (!done.load()) {
+      check_size();
+    }
+  });
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  done.store(true);
+  checker.join();
+
+  CHECK(in_range.load());
+  CHECK(buffer.size() == 0);
+  CHECK(buffer.empty());
+}
+
+// 记录拷贝次数，验证 channel 内部全程移动
+struct CopyCounter {
+  static inline int copies = 0;
+
+  int value{};
+
+  CopyCounter() = default;
+  explicit CopyCounter(int value) : value(value) {}
+  CopyCounter(const CopyCounter &other) : value(other.value) { ++copies; }
+  CopyCounter(CopyCounter &&other) noexcept = default;
+  CopyCounter &operator=(const CopyCounter &other) {
+    value = other.value;
+    ++copies;
+    return *this;
+  }
+  CopyCounter &operator=(CopyCounter &&other) noexcept = default;
+};
+
+Task<void, LooperExecutor> unique_producer(Channel<std::unique_ptr<int>> &channel, int count) {
+  for (int i = 0; i < count; ++i) {
+    co_await channel.write(std::make_unique<int>(i));
+  }
+}
+
+Task<int, LooperExecutor> unique_consumer(Channel<std::unique_ptr<int>> &channel, int count) {
+  int sum = 0;
+  for (int i = 0; i < count; ++i) {
+    std::unique_ptr<int> value = co_await channel.read();
+    sum += *value;
+  }
+  co_return sum;
+}
+
+Task<void, LooperExecutor> copy_producer(Channel<CopyCounter> &channel, int count) {
+  for (int i = 0; i < count; ++i) {
+    co_await channel.write(CopyCounter(i));
+  }
+}
+
+Task<int, LooperExecutor> copy_consumer(Channel<CopyCounter> &channel, int count) {
+  int sum = 0;
+  for (int i = 0; i < count; ++i) {
+    CopyCounter value;
+    co_await (channel >> value);
+    sum += value.value;
+  }
+  co_return sum;
+}
+
+// 仅可移动且没有默认构造函数，记录存活个数，验证缓冲区析构时原地析构剩余元素
+struct MoveOnly {
+  static inline int alive = 0;
+
+  int value;
+
+  explicit MoveOnly(int value) : value(value) { ++alive; }
+  MoveOnly(MoveOnly &&other) noexcept : value(other.value) { ++alive; }
+  MoveOnly(const MoveOnly &other) = delete;
+  MoveOnly &operator=(MoveOnly &&other) noexcept = default;
+  MoveOnly &operator=(const MoveOnly &other) = delete;
+  ~MoveOnly() { --alive; }
+};
+
+template <typename Channel_>
+Task<void, LooperExecutor> move_only_producer(Channel_ &channel, int count) {
+  // 逐个写入一半，其余批量写入
+  for (int i = 0; i < count / 2; ++i) {
+    co_await channel.write(MoveOnly(i));
+  }
+
+  std::vector<MoveOnly> values;
+  for (int i = count / 2; i < count; ++i) {
+    values.emplace_back(i);
+  }
+  for (std::span<MoveOnly> rest(values); !rest.empty();) {
+    rest = rest.subspan(co_await channel.write_batch(rest));
+  }
+  channel.close();
+}
+
+template <typename Channel_>
+Task<int, LooperExecutor> move_only_consumer(Channel_ &channel) {
+  int sum = 0;
+  MoveOnly first = co_await channel.read();
+  sum += first.value;
+
+  auto batch = co_await channel.read_batch(4);
+  for (auto &value : batch) {
+    sum += value.value;
+  }
+
+  while (auto received = co_await channel.read_result()) {
+    sum += received.value().value;
+  }
+  co_return sum;
+}
+
+TEST_CASE("move only values") {
+  constexpr int kCount = 100;
+  constexpr int kSum = kCount * (kCount - 1) / 2;
+
+  // 有缓冲及无缓冲 channel 均支持仅可移动类型
+  for (int capacity : {0, 4}) {
+    auto channel = Channel<std::unique_ptr<int>>(capacity);
+    auto producer = unique_producer(channel, kCount);
+    auto consumer = unique_consumer(channel, kCount);
+    CHECK(consumer.get_result() == kSum);
+    producer.get_result();
+  }
+
+  for (int capacity : {0, 4}) {
+    CopyCounter::copies = 0;
+    auto channel = Channel<CopyCounter>(capacity);
+    auto producer = copy_producer(channel, kCount);
+    auto consumer = copy_consumer(channel, kCount);
+    CHECK(consumer.get_result() == kSum);
+    producer.get_result();
+    CHECK(CopyCounter::copies == 0);
+  }
+
+  // 没有默认构造函数的仅可移动类型
+  for (int capacity : {0, 4}) {
+    auto channel = Channel<MoveOnly>(capacity);
+    auto producer = move_only_producer(channel, kCount);
+    auto consumer = move_only_consumer(channel);
+    CHECK(consumer.get_result() == kSum);
+    producer.get_result();
+  }
+  {
+    auto channel = UnboundedChannel<MoveOnly>(4);
+    auto producer = move_only_producer(channel, kCount);
+    auto consumer = move_only_consumer(channel);
+    CHECK(consumer.get_result() == kSum);
+    producer.get_result();
+  }
+  CHECK(MoveOnly::alive == 0);
+
+  // 非阻塞读写，以及析构时缓冲区中剩余的元素
+  {
+    auto channel = Channel<MoveOnly>(4);
+    auto spsc = SpscChannel<MoveOnly>(4);
+    auto unbounded = UnboundedChannel<MoveOnly>(2);
+    for (int i = 0; i < 3; ++i) {
+      CHECK(channel.try_write(MoveOnly(i)));
+      CHECK(spsc.try_write(MoveOnly(i)));
+      CHECK(unbounded.try_write(MoveOnly(i)));
+    }
+
+    auto value = channel.try_read();
+    CHECK((value && value->value == 0));
+    CHECK(MoveOnly::alive == 9);
+  }
+  CHECK(MoveOnly::alive == 0);
+}
+
+Task<std::string, LooperExecutor> string_target_consumer(Channel<std::string> &channel) {
+  std::string first;
+  std::string second;
+  co_await (channel >> first);
+  co_await (channel >> second);
+  co_return first + second;
+}
+
+Task<int, LooperExecutor> unique_target_consumer(Channel<std::unique_ptr<int>> &channel) {
+  auto value = std::make_unique<int>(-1);
+  co_await (channel >> value);
+  co_return *value;
+}
+
+TEST_CASE("read into target") {
+  // operator>> 将值直接移动至目标变量，不经过 ReaderAwaiter::value_
+  for (int capacity : {0, 4}) {
+    auto channel = Channel<std::string>(capacity);
+    auto consumer = string_target_consumer(channel);
+    auto producer = [](Channel<std::string> &channel) -> Task<void, LooperExecutor> {
+      co_await (channel << std::string(32, 'a'));
+      co_await (channel << std::string(32, 'b'));
+    }(channel);
+    CHECK(consumer.get_result() == std::string(32, 'a') + std::string(32, 'b'));
+    producer.get_result();
+  }
+
+  for (int capacity : {0, 4}) {
+    auto channel = Channel<std::unique_ptr<int>>(capacity);
+    auto consumer = unique_target_consumer(channel);
+    auto producer = unique_producer(channel, 1);
+    CHECK(consumer.get_result() == 0);
+    producer.get_result();
+  }
+
+  // channel 关闭且读完后抛出异常
+  auto closed = Channel<std::string>(4);
+  CHECK(closed.try_write(std::string("last")));
+  closed.close();
+  auto reader = [](Channel<std::string> &channel) -> Task<std::string, NoopExecuter> {
+    std::string value;
+    co_await (channel >> value);
+    co_await (channel >> value);
+    co_return value;
+  }(closed);
+  CHECK_THROWS(reader.get_result());
+}
+
+Task<long long, ThreadPoolExecutor> select_consumer(Channel<int> &first, Channel<int> &second, int count) {
+  long long sum = 0;
+  int value = 0;
+  for (int i = 0; i < count; ++i) {
+    auto first_case = case_read(first);
+    switch (co_await select(first_case, case_read(second, value))) {
+    case 0:
+      sum += first_case.value();
+      break;
+    case 1:
+      sum += value;
+      break;
+    }
+  }
+  co_return sum;
+}
+
+Task<int, NoopExecuter> select_once(Channel<int> &channel) {
+  co_return co_await select(case_read(channel), case_timeout(20ms));
+}
+
+TEST_CASE("select") {
+  constexpr int kCount = 10000;
+  auto pool = ThreadPoolExecutor(4);
+  SharedExecutor<ThreadPoolExecutor>::set(&pool);
+
+  // 同时等待有缓冲与无缓冲 channel，所有写入恰好被读取一次
+  {
+    auto first = Channel<int>();
+    auto second = Channel<int>(4);
+    auto first_producer = pool_producer(first, kCount);
+    auto second_producer = pool_producer(second, kCount);
+    auto consumer = select_consumer(first, second, 2 * kCount);
+    CHECK(consumer.get_result() == 2LL * kCount * (kCount + 1) / 2);
+    first_producer.get_result();
+    second_producer.get_result();
+  }
+
+  pool.shutdown();
+  pool.join();
+  SharedExecutor<ThreadPoolExecutor>::set(nullptr);
+
+  // 写分支在缓冲区有空间时立即完成，均未就绪时选中默认分支
+  auto write_once = [](Channel<int> &channel) -> Task<int, NoopExecuter> {
+    co_return co_await select(case_write(channel, 42), default_case);
+  };
+  auto channel = Channel<int>(1);
+  auto unbuffered = Channel<int>();
+  CHECK(write_once(channel).get_result() == 0);
+  CHECK(write_once(unbuffered).get_result() == 1);
+
+  // 超时后选中超时分支，之后的读取不受影响
+  CHECK(select_once(unbuffered).get_result() == 1);
+  CHECK(select_once(channel).get_result() == 0);
+
+  // LooperExecutor 上的超时由执行器自身的时间轮管理
+  auto looper_select = [](Channel<int> &channel) -> Task<int, LooperExecutor> {
+    co_return co_await select(case_read(channel), case_timeout(20ms));
+  };
+  CHECK(looper_select(unbuffered).get_result() == 1);
+  CHECK(channel.try_write(5));
+  CHECK(looper_select(channel).get_result() == 0);
+}
+
+Task<void, ThreadPoolExecutor> broadcast_producer(BroadcastChannel<int> &channel, int count) {
+  for (int i = 1; i <= count; ++i) {
+    co_await channel.write(i);
+  }
+  channel.close();
+}
+
+Task<long long, ThreadPoolExecutor> broadcast_consumer(BroadcastChannel<int>::Subscriber &subscriber) {
+  long long sum = 0;
+  while (auto value = co_await subscriber.read_optional()) {
+    sum += **value;
+  }
+  co_return sum;
+}
+
+TEST_CASE("broadcast channel") {
+  constexpr int kCount = 10000;
+  auto pool = ThreadPoolExecutor(4);
+  SharedExecutor<ThreadPoolExecutor>::set(&pool);
+
+  // kBlock：每个订阅者均完整收到所有值，关闭后读完剩余数据再结束
+  {
+    auto channel = BroadcastChannel<int>(8);
+    auto first = BroadcastChannel<int>::Subscriber(channel);
+    auto second = BroadcastChannel<int>::Subscriber(channel);
+    auto third = BroadcastChannel<int>::Subscriber(channel);
+    auto consumer1 = broadcast_consumer(first);
+    auto consumer2 = broadcast_consumer(second);
+    auto consumer3 = broadcast_consumer(third);
+    auto producer = broadcast_producer(channel, kCount);
+
+    auto expected = 1LL * kCount * (kCount + 1) / 2;
+    CHECK(consumer1.get_result() == expected);
+    CHECK(consumer2.get_result() == expected);
+    CHECK(consumer3.get_result() == expected);
+    producer.get_result();
+  }
+
+  pool.shutdown();
+  pool.join();
+  SharedExecutor<ThreadPoolExecutor>::set(nullptr);
+
+  // kDropOldest：写方不阻塞，慢订阅者跳过被覆盖的值
+  {
+    auto channel = BroadcastChannel<int>(4, BroadcastPolicy::kDropOldest);
+    auto subscriber = BroadcastChannel<int>::Subscriber(channel);
+    for (int i = 0; i < 10; ++i) {
+      CHECK(channel.try_write(i));
+    }
+    CHECK(**subscriber.try_read() == 6);
+    CHECK(subscriber.dropped() == 6);
+  }
+
+  // 容量不是 2 的幂时，最慢订阅者至多落后声明的容量
+  {
+    auto channel = BroadcastChannel<int>(3);
+    auto subscriber = BroadcastChannel<int>::Subscriber(channel);
+    CHECK(channel.capacity() == 3);
+    for (int i = 0; i < 3; ++i) {
+      CHECK(channel.try_write(i));
+    }
+    CHECK_FALSE(channel.try_write(3));
+    CHECK(**subscriber.try_read() == 0);
+    CHECK(channel.try_write(3));
+  }
+
+  // kDisconnect：断开慢订阅者，其余订阅者不受影响
+  {
+    auto channel = BroadcastChannel<int>(4, BroadcastPolicy::kDisconnect);
+    auto slow = BroadcastChannel<int>::Subscriber(channel);
+    auto fast = BroadcastChannel<int>::Subscriber(channel);
+    for (int i = 0; i < 10; ++i) {
+      CHECK(channel.try_write(i));
+      CHECK(**fast.try_read() == i);
+    }
+    CHECK(slow.is_disconnected());
+    CHECK_THROWS(slow.try_read());
+    CHECK(channel.subscriber_count() == 1);
+  }
+
+  // 写入只存储一次，所有订阅者共享同一个值，不发生拷贝
+  {
+    CopyCounter::copies = 0;
+    auto channel = BroadcastChannel<CopyCounter>(4);
+    auto first = BroadcastChannel<CopyCounter>::Subscriber(channel);
+    auto second = BroadcastChannel<CopyCounter>::Subscriber(channel);
+    auto third = BroadcastChannel<CopyCounter>::Subscriber(channel);
+    CHECK(channel.try_write(CopyCounter(7)));
+
+    auto value = *first.try_read();
+    CHECK(value->value == 7);
+    CHECK(*second.try_read() == value);
+    CHECK(*third.try_read() == value);
+    CHECK(CopyCounter::copies == 0);
+  }
+}
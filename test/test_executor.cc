@@ -42,6 +42,10 @@ Task<int, LooperExecutor> simple_task() {
 	co_return 1 + result2 + result3;
 }
 
+Task<int, GolangExecutor> golang_task(int value) {
+	co_return value * 2;
+}
+
 void test_tasks() {
 	auto simpleTask = simple_task();
 	simpleTask.then([](int i) { DEBUGFMTLOG("simple task end: {}", i); })
@@ -75,3 +79,195 @@ TEST_CASE("Task") {
 	looper.shutdown(false);		// 析构函数中存在 shutdown 调用
 	std::this_thread::sleep_for(1s);
 }
+
+TEST_CASE("GolangExecutor") {
+
+	std::atomic<int> counter{0};
+	{
+		auto executor = GolangExecutor(4);
+
+		// 外部线程投递至全局队列，任务内再次投递至本地队列，由空闲线程窃取执行
+		for (int i = 0; i < 1000; ++i) {
+			executor.execute([&executor, &counter]() {
+				counter.fetch_add(1, std::memory_order_relaxed);
+				executor.execute([&counter]() {
+					counter.fetch_add(1, std::memory_order_relaxed);
+				});
+			});
+		}
+
+		// 关闭后不再接收新任务，因此等待任务内投递的任务全部执行完成
+		using namespace std::chrono_literals;
+		while (counter.load(std::memory_order_relaxed) < 2000) {
+			std::this_thread::sleep_for(1ms);
+		}
+
+		executor.shutdown();
+		executor.join();
+	}
+
+	DEBUGFMTLOG("golang executor counter: {}", counter.load());
+	CHECK(counter.load() == 2000);
+
+	// 定时事件由调度器自行管理，可在工作线程内添加，关闭后仍等待剩余定时事件到期执行
+	std::atomic<int> fired{0};
+	std::atomic<int> added{0};
+	{
+		auto executor = GolangExecutor(4);
+		for (int i = 0; i < 100; ++i) {
+			executor.execute([&executor, &fired, &added, i]() {
+				executor.execute_after(
+				    [&fired]() { fired.fetch_add(1, std::memory_order_relaxed); },
+				    std::chrono::milliseconds(1 + i % 5));
+				added.fetch_add(1, std::memory_order_release);
+			});
+		}
+
+		auto handle = executor.execute_after(
+		    [&fired]() { fired.fetch_add(1000, std::memory_order_relaxed); },
+		    std::chrono::milliseconds(100));
+		CHECK(handle.cancel());
+
+		// 等待任务内添加的定时事件全部添加完成后再关闭
+		using namespace std::chrono_literals;
+		while (added.load(std::memory_order_acquire) < 100) {
+			std::this_thread::sleep_for(1ms);
+		}
+
+		executor.shutdown();
+		executor.join();
+	}
+	CHECK(fired.load() == 100);
+
+	auto task = golang_task(21);
+	CHECK(task.get_result() == 42);
+}
+
+Task<int, LooperExecutor> looper_task(int value) { co_return value; }
+
+TEST_CASE("LooperExecutor schedule") {
+
+	// 超过环形队列容量的协程通过 execute 回退路径调度
+	constexpr int kTaskCount = 10000;
+
+	std::vector<Task<int, LooperExecutor>> tasks;
+	tasks.reserve(kTaskCount);
+	for (int i = 0; i < kTaskCount; ++i) {
+		tasks.emplace_back(looper_task(i));
+	}
+
+	long long sum = 0;
+	for (auto& task : tasks) {
+		sum += task.get_result();
+	}
+
+	CHECK(sum == static_cast<long long>(kTaskCount) * (kTaskCount - 1) / 2);
+}
+
+Task<bool, LooperExecutor> looper_sleep_task() {
+	using namespace std::chrono_literals;
+
+	// 定时事件由执行线程自行处理，延时前后位于同一线程
+	auto thread_id = std::this_thread::get_id();
+	co_await 2ms;
+	co_await 500us;
+	co_return std::this_thread::get_id() == thread_id;
+}
+
+TEST_CASE("LooperExecutor timer") {
+
+	auto start = std::chrono::steady_clock::now();
+	auto task = looper_sleep_task();
+	CHECK(task.get_result());
+	CHECK(std::chrono::steady_clock::now() - start >=
+	      std::chrono::microseconds(2500));
+
+	// 到期前取消，重复取消返回 false
+	auto executor = LooperExecutor();
+	auto handle = executor.schedule_after(std::noop_coroutine(),
+	                                      std::chrono::milliseconds(100));
+	CHECK(handle.cancel());
+	CHECK(!handle.cancel());
+}
+
+Task<int, ThreadPoolExecutor> pool_task(int value) { co_return value + 1; }
+
+TEST_CASE("ThreadPoolExecutor") {
+
+	std::atomic<int> counter{0};
+	{
+		auto pool = ThreadPoolExecutor(4);
+		CHECK(pool.worker_count() == 4);
+
+		for (int i = 0; i < 1000; ++i) {
+			pool.execute([&counter]() {
+				counter.fetch_add(1, std::memory_order_relaxed);
+			});
+		}
+
+		// 等待已投递任务全部执行完成后退出
+		pool.shutdown();
+		pool.join();
+	}
+	CHECK(counter.load() == 1000);
+
+	// 替换共享实例，Task 使用自定义线程数的线程池
+	auto pool = ThreadPoolExecutor(2);
+	SharedExecutor<ThreadPoolExecutor>::set(&pool);
+
+	auto task = pool_task(1);
+	CHECK(task.get_result() == 2);
+
+	SharedExecutor<ThreadPoolExecutor>::set(nullptr);
+}
+
+Task<int, ThreadPoolExecutor> pool_sleep_task(int value) {
+	using namespace std::chrono_literals;
+	co_await 2ms;
+	co_return value;
+}
+
+TEST_CASE("ThreadPoolExecutor timer") {
+
+	// 定时事件由线程池自行管理，关闭后仍等待剩余定时事件到期执行
+	std::atomic<int> fired{0};
+	{
+		auto pool = ThreadPoolExecutor(2);
+		auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < 100; ++i) {
+			pool.execute_after(
+			    [&fired]() { fired.fetch_add(1, std::memory_order_relaxed); },
+			    std::chrono::milliseconds(1 + i % 5));
+		}
+
+		// 到期前取消，重复取消返回 false
+		auto handle = pool.execute_after(
+		    [&fired]() { fired.fetch_add(1000, std::memory_order_relaxed); },
+		    std::chrono::milliseconds(100));
+		CHECK(handle.cancel());
+		CHECK(!handle.cancel());
+
+		pool.shutdown();
+		pool.join();
+		CHECK(std::chrono::steady_clock::now() - start >=
+		      std::chrono::milliseconds(5));
+	}
+	CHECK(fired.load() == 100);
+
+	// 协程延时到期后在工作线程上恢复
+	auto pool = ThreadPoolExecutor(2);
+	SharedExecutor<ThreadPoolExecutor>::set(&pool);
+
+	std::vector<Task<int, ThreadPoolExecutor>> tasks;
+	for (int i = 0; i < 100; ++i) {
+		tasks.emplace_back(pool_sleep_task(i));
+	}
+
+	int sum = 0;
+	for (auto& task : tasks) {
+		sum += task.get_result();
+	}
+	CHECK(sum == 100 * 99 / 2);
+
+	SharedExecutor<ThreadPoolExecutor>::set(nullptr);
+}
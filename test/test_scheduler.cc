@@ -2,7 +2,13 @@
 #include "gocoroutine/executor.h"
 #include "gocoroutine/scheduler.h"
 #include "gocoroutine/task.h"
+#include "gocoroutine/ticker.h"
+#include "gocoroutine/timing_wheel.h"
 #include "gocoroutine/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest/doctest.h"
@@ -35,12 +41,175 @@ TEST_CASE("Scheduler") {
     scheduler.execute([]() { DEBUGFMTLOG("6"); }, 1000);
     scheduler.execute([]() { DEBUGFMTLOG("4"); }, 300);
 
+    // 取消后不再执行，重复取消返回 false
+    bool fired = false;
+    auto handle = scheduler.execute([&fired]() { fired = true; }, 100);
+    CHECK(handle.cancel());
+    CHECK(!handle.cancel());
+
     scheduler.shutdown();
     scheduler.join();
+    CHECK(!fired);
 
     DEBUGFMTLOG("end");
 }
 
+TEST_CASE("TimingWheel") {
+
+	// 覆盖多个层级及 cascade 边界，验证每个事件恰好在到期 tick 被取出
+	constexpr int64_t kStartTick = 1000003;
+	auto wheel = TimingWheel(kStartTick);
+
+	std::vector<int64_t> fired;
+	std::vector<int64_t> expected;
+	uint64_t seed = 42;
+	for (int i = 0; i < 10000; ++i) {
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		int64_t delay = static_cast<int64_t>(seed >> 33) % (1 << 20);
+		int64_t expire = kStartTick + delay;
+
+		expected.push_back(expire);
+		wheel.add([&fired, expire]() { fired.push_back(expire); }, expire);
+	}
+	CHECK(wheel.size() == expected.size());
+
+	IntrusiveList<DelayedExecutable> expired;
+	int64_t tick = kStartTick;
+	while (!wheel.empty()) {
+		tick = wheel.next_time();
+		wheel.advance(tick, expired);
+
+		while (auto executable = expired.pop_front()) {
+			CHECK(executable->get_scheduled_time() == tick);
+			(*executable)();
+			wheel.release(executable);
+		}
+	}
+
+	std::sort(expected.begin(), expected.end());
+	CHECK(fired == expected);
+
+	// 每个 tick 覆盖 1000 个时间单位，同一 tick 内的事件按精确到期时间取出
+	auto coarse_wheel = TimingWheel(kStartTick, 1000);
+	coarse_wheel.add([]() {}, kStartTick + 250);
+	coarse_wheel.add([]() {}, kStartTick + 700);
+	CHECK(coarse_wheel.next_time() == kStartTick + 250);
+
+	coarse_wheel.advance(kStartTick + 249, expired);
+	CHECK(expired.empty());
+
+	coarse_wheel.advance(kStartTick + 250, expired);
+	CHECK(expired.size() == 1);
+	CHECK(coarse_wheel.next_time() == kStartTick + 700);
+	coarse_wheel.release(expired);
+
+	coarse_wheel.advance(kStartTick + 1000, expired);
+	CHECK(expired.size() == 1);
+	coarse_wheel.release(expired);
+
+	// slack 窗口内的定时事件对齐到同一时刻到期，仅需一次唤醒
+	auto slack_wheel = TimingWheel(0, 1000);
+	for (int64_t expire : {5, 50, 99, 101}) {
+		slack_wheel.add([]() {}, expire, 100);
+	}
+	CHECK(slack_wheel.next_time() == 100);
+
+	slack_wheel.advance(99, expired);
+	CHECK(expired.empty());
+
+	slack_wheel.advance(100, expired);
+	CHECK(expired.size() == 3);
+	CHECK(expired.front()->get_scheduled_time() == 5);
+	CHECK(slack_wheel.next_time() == 200);
+	slack_wheel.release(expired);
+
+	// 取消未到期事件，重复取消失败
+	auto node = coarse_wheel.add([]() {}, kStartTick + 5000);
+	auto id = node->get_id();
+	CHECK(coarse_wheel.cancel(node, id));
+	CHECK(coarse_wheel.empty());
+	CHECK(coarse_wheel.next_time() < 0);
+	CHECK(!coarse_wheel.cancel(node, id));
+
+	// 回收节点被复用后，旧 id 无法取消新事件
+	for (int i = 0; i < 3; ++i) {
+		coarse_wheel.add([]() {}, kStartTick + 6000);
+	}
+	CHECK(!coarse_wheel.cancel(node, id));
+	CHECK(coarse_wheel.size() == 3);
+}
+
+TEST_CASE("periodic") {
+
+	auto scheduler = Scheduler();
+
+	// 两种策略各自复用同一定时事件，取消后不再执行
+	std::atomic<int> fixed_rate{0};
+	std::atomic<int> fixed_delay{0};
+	auto rate_handle = scheduler.schedule_periodic(
+	    [&fixed_rate]() { fixed_rate.fetch_add(1); },
+	    std::chrono::milliseconds(2));
+	auto delay_handle = scheduler.schedule_periodic(
+	    [&fixed_delay]() { fixed_delay.fetch_add(1); },
+	    std::chrono::milliseconds(2), PeriodicPolicy::kFixedDelay);
+
+	while (fixed_rate.load() < 5 || fixed_delay.load() < 5) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	CHECK(rate_handle.cancel());
+	CHECK(delay_handle.cancel());
+	int rate_count = fixed_rate.load();
+	int delay_count = fixed_delay.load();
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	CHECK(fixed_rate.load() <= rate_count + 1);
+	CHECK(fixed_delay.load() <= delay_count + 1);
+
+	scheduler.shutdown();
+	scheduler.join();
+}
+
+Task<int, NoopExecuter> ticker_task() {
+	using namespace std::chrono_literals;
+	auto ticker = Ticker(1ms);
+
+	// 每次触发时间严格递增
+	int count = 0;
+	auto last = Ticker::Clock::time_point();
+	for (int i = 0; i < 5; ++i) {
+		auto tick_time = co_await ticker.tick();
+		count += tick_time > last;
+		last = tick_time;
+	}
+
+	co_return count;
+}
+
+TEST_CASE("Ticker") {
+
+	auto start = std::chrono::steady_clock::now();
+	CHECK(ticker_task().get_result() == 5);
+	CHECK(std::chrono::steady_clock::now() - start >=
+	      std::chrono::milliseconds(5));
+}
+
+Task<int64_t, NoopExecuter> microsecond_sleep_task() {
+	using namespace std::chrono_literals;
+	auto start = std::chrono::steady_clock::now();
+	co_await 200us;
+	co_return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	    std::chrono::steady_clock::now() - start)
+	    .count();
+}
+
+TEST_CASE("microsecond sleep") {
+
+	// 亚毫秒级延时不会被截断为 0
+	auto elapsed = microsecond_sleep_task().get_result();
+	CHECK(elapsed >= 200000);
+}
+
 Task<void, NoopExecuter> simple_task1() {
 	DEBUGFMTLOG("in task 1 start ...");
 	using namespace std::chrono_literals;
@@ -1,7 +1,8 @@
-
 #include "gocoroutine/task.h"
 #include "gocoroutine/utils.h"
 
+#include <stdexcept>
+
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest/doctest.h"
 
@@ -43,6 +44,15 @@ Task<int> simple_task() {
 	co_return 1 + result2 + result3;
 }
 
+// 深层 co_await 调用链，每一层在调度线程上启动，结束时通过对称转移恢复上一层
+Task<int, LooperExecutor> chain_task(int depth) {
+	if (depth == 0)
+		co_return 0;
+
+	auto result = co_await chain_task(depth - 1);
+	co_return result + 1;
+}
+
 TEST_CASE("fmtlog") {
 
 	SETLOGLEVEL(fmtlog::LogLevel::DBG);
@@ -65,3 +75,103 @@ TEST_CASE("Task") {
 		DEBUGFMTLOG("error: ", e.what());
 	}
 }
+
+TEST_CASE("symmetric transfer") {
+	constexpr int kDepth = 100000;
+
+	auto task = chain_task(kDepth);
+	CHECK(task.get_result() == kDepth);
+}
+
+// 先挂起等待，保证回调在协程结束前完成注册
+Task<int, LooperExecutor> delayed_task() {
+	using namespace std::chrono_literals;
+	co_await 100ms;
+	co_return 2;
+}
+
+TEST_CASE("task completion") {
+	// 完成状态仅包含结果、原子状态字、continuation 及回调链表头
+	DEBUGFMTLOG("sizeof(Task<int>::promise_type): {}",
+	            sizeof(Task<int>::promise_type));
+	CHECK(sizeof(Task<int>::promise_type) <= 64);
+
+	std::atomic<int> callbacks{0};
+	auto task = simple_task2();
+	task.then([&callbacks](int i) { callbacks.fetch_add(i); })
+	    .finally([&callbacks]() { callbacks.fetch_add(1); });
+
+	CHECK(task.get_result() == 2);
+	CHECK(callbacks.load() == 3);
+
+	// 完成后注册的回调直接执行
+	task.finally([&callbacks]() { callbacks.fetch_add(1); });
+	CHECK(callbacks.load() == 4);
+
+	// final_suspend 中执行的回调抛出异常被忽略，后续回调照常执行
+	auto throwing = delayed_task();
+	throwing.finally([]() { throw std::runtime_error("callback"); })
+	    .finally([&callbacks]() { callbacks.fetch_add(1); });
+	CHECK(throwing.get_result() == 2);
+	CHECK(callbacks.load() == 5);
+
+	// 阻塞等待返回后立即销毁 Task，完成方不能再访问已释放的协程帧
+	for (int i = 0; i < 1000; ++i) {
+		auto looper_task = chain_task(1);
+		CHECK(looper_task.get_result() == 1);
+	}
+}
+
+// 记录分配次数的分配器，用于验证 std::allocator_arg_t 协程帧分配
+template <typename T> struct CountingAllocator {
+	using value_type = T;
+
+	explicit CountingAllocator(int* count)
+	    : count_(count) {}
+
+	template <typename U>
+	CountingAllocator(const CountingAllocator<U>& other)
+	    : count_(other.count_) {}
+
+	T* allocate(std::size_t n) {
+		++*count_;
+		return std::allocator<T>().allocate(n);
+	}
+
+	void deallocate(T* ptr, std::size_t n) {
+		--*count_;
+		std::allocator<T>().deallocate(ptr, n);
+	}
+
+	int* count_{};
+};
+
+Task<int, NoopExecuter> allocator_task(std::allocator_arg_t,
+                                       [[maybe_unused]] CountingAllocator<int> allocator,
+                                       int value) {
+	co_return value;
+}
+
+Task<int, NoopExecuter> pooled_task(int value) { co_return value; }
+
+TEST_CASE("frame allocation") {
+
+	// 首次分配未命中，此后同一线程上复用已释放的协程帧
+	for (int i = 0; i < 100; ++i) {
+		auto task = pooled_task(i);
+		CHECK(task.get_result() == i);
+	}
+
+	auto stats = FramePool::stats();
+	DEBUGFMTLOG("frame pool hits: {}, misses: {}", stats.hits, stats.misses);
+	CHECK(stats.hits >= 99);
+
+	int count = 0;
+	{
+		auto task =
+		    allocator_task(std::allocator_arg, CountingAllocator<int>(&count), 1);
+		CHECK(count == 1);
+		CHECK(task.get_result() == 1);
+	}
+	CHECK(count == 0);
+}
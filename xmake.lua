@@ -15,6 +15,7 @@ target("test_task")
 
     -- add_files("src/*.cc")
     add_files("test/test_task.cc")
+    add_defines("_GLIBCXX_ASSERTIONS")
 
 
 target("test_executor")
@@ -22,6 +23,7 @@ target("test_executor")
 
     -- add_files("src/*.cc")
     add_files("test/test_executor.cc")
+    add_defines("_GLIBCXX_ASSERTIONS")
 
 
 target("test_scheduler")
@@ -29,6 +31,7 @@ target("test_scheduler")
 
     -- add_files("src/*.cc")
     add_files("test/test_scheduler.cc")
+    add_defines("_GLIBCXX_ASSERTIONS")
 
 
 target("test_channel")
@@ -36,10 +39,33 @@ target("test_channel")
 
     -- add_files("src/*.cc")
     add_files("test/test_channel.cc")
+    add_defines("_GLIBCXX_ASSERTIONS")
 
 -- coroutine test end
 
 
+-- coroutine bench begin
+target("bench_task_spawn")
+    set_kind("binary")
+
+    add_files("bench/bench_task_spawn.cc")
+
+
+target("bench_timer")
+    set_kind("binary")
+
+    add_files("bench/bench_timer.cc")
+
+
+target("bench_channel")
+    set_kind("binary")
+
+    add_files("bench/bench_channel.cc")
+    add_cxxflags("-O2")
+
+-- coroutine bench end
+
+
 -- coroutine static begin
 
 